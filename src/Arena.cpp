@@ -0,0 +1,102 @@
+// Arena.cpp
+#include "Arena.h"
+#include "Profiler.h"
+#include <cstdlib>
+#include <new>
+
+Arena::Arena() : current(0), offset(0), bytes(0), count(0), grows(0) {}
+
+void* Arena::allocate(size_t size, size_t alignment) {
+    ++count;
+    bytes += size;
+    while (current < blocks.size()) {
+        Block& block = blocks[current];
+        size_t start = (offset + alignment - 1) & ~(alignment - 1);
+        if (start + size <= block.size) {
+            offset = start + size;
+            return block.data + start;
+        }
+        ++current;
+        offset = 0;
+    }
+
+    // Nouveau bloc, assez grand pour la demande ; malloc aligne pour tout type fondamental
+    size_t blockSize = blocks.empty() ? MIN_BLOCK_SIZE : blocks.back().size * 2;
+    if (blockSize < size) {
+        blockSize = size;
+    }
+    Block block = { static_cast<char*>(malloc(blockSize)), blockSize };
+    if (!block.data) {
+        throw std::bad_alloc();
+    }
+    blocks.push_back(block);
+    ++grows;
+    current = blocks.size() - 1;
+    offset = size;
+    return block.data;
+}
+
+void Arena::reset() {
+    if (blocks.size() > 1) {
+        // Un seul bloc de la capacité totale pour les pas suivants
+        size_t total = 0;
+        for (const auto& block : blocks) {
+            total += block.size;
+        }
+        release();
+        Block block = { static_cast<char*>(malloc(total)), total };
+        if (block.data) {
+            blocks.push_back(block);
+        }
+    }
+    current = 0;
+    offset = 0;
+    bytes = count = grows = 0;
+}
+
+void Arena::release() {
+    for (const auto& block : blocks) {
+        free(block.data);
+    }
+    blocks.clear();
+    current = 0;
+    offset = 0;
+}
+
+size_t Arena::used() const {
+    return bytes;
+}
+
+size_t Arena::allocations() const {
+    return count;
+}
+
+size_t Arena::blockAllocations() const {
+    return grows;
+}
+
+static Arena frame;
+static Arena step;
+
+static void publishAndReset(Arena& arena) {
+    profilerAdd(PROFILE_ARENA_BYTES, static_cast<long long>(arena.used()));
+    profilerAdd(PROFILE_ARENA_ALLOCATIONS, static_cast<long long>(arena.allocations()));
+    profilerAdd(PROFILE_ARENA_GROWS, static_cast<long long>(arena.blockAllocations()));
+    arena.reset();
+}
+
+Arena& frameArena() {
+    return frame;
+}
+
+Arena& stepArena() {
+    return step;
+}
+
+void resetFrameArena() {
+    publishAndReset(frame);
+}
+
+void resetStepArena() {
+    publishAndReset(step);
+}
@@ -0,0 +1,69 @@
+// Arena.h
+#ifndef ARENA_H
+#define ARENA_H
+
+#include <cstddef>
+#include <vector>
+
+// Allocateur linéaire pour les données transitoires : chaque allocation avance un pointeur
+// dans un bloc, et reset() libère tout d'un coup. Quand un pas a dû ouvrir plusieurs blocs,
+// ils sont fusionnés en un seul au reset suivant : en régime établi, aucun appel au système.
+// Les objets ne sont ni construits ni détruits : réservé aux types triviaux.
+// Non thread-safe : un seul thread alloue à la fois (les tâches qui allouent sont ordonnées
+// par le graphe du pas), puis les pointeurs sont partagés.
+class Arena {
+public:
+    Arena();
+
+    void* allocate(size_t size, size_t alignment = alignof(double));
+
+    template <typename T>
+    T* allocateArray(size_t count) {
+        return static_cast<T*>(allocate(count * sizeof(T), alignof(T)));
+    }
+
+    // Tableau mis à zéro
+    template <typename T>
+    T* allocateZeroed(size_t count) {
+        T* data = allocateArray<T>(count);
+        for (size_t k = 0; k < count; ++k) {
+            data[k] = T();
+        }
+        return data;
+    }
+
+    void reset();
+    void release(); // Rend aussi la mémoire au système
+
+    size_t used() const;        // Octets alloués depuis le dernier reset
+    size_t allocations() const; // Allocations depuis le dernier reset
+    size_t blockAllocations() const; // Blocs demandés au système depuis le dernier reset
+
+private:
+    struct Block {
+        char* data;
+        size_t size;
+    };
+
+    static const size_t MIN_BLOCK_SIZE = 64 * 1024;
+
+    std::vector<Block> blocks;
+    size_t current; // Bloc en cours de remplissage
+    size_t offset;  // Position dans ce bloc
+    size_t bytes, count, grows;
+};
+
+// Arène de l'image en cours : rendu, sur le thread qui dessine
+Arena& frameArena();
+
+// Arène du pas de simulation : thread qui exécute le pas, ou tâches du pas dont le graphe
+// garantit qu'elles n'allouent pas en même temps. Séparée de la précédente pour que le pas
+// puisse tourner sur un autre thread que le rendu (--async-physics).
+Arena& stepArena();
+
+// Fin de l'image ou du pas : publie les statistiques dans le profiler puis libère l'arène.
+// Aucun pointeur obtenu de l'arène ne doit survivre à cet appel.
+void resetFrameArena();
+void resetStepArena();
+
+#endif // ARENA_H
@@ -0,0 +1,268 @@
+// BarnesHut.cpp
+#include "BarnesHut.h"
+#include "Arena.h"
+#include "SpatialOrder.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+
+static const int MORTON_LEVELS = MORTON_BITS;
+static const int TRAVERSAL_STACK = 8 * 64;
+
+struct KeyedBody {
+    uint64_t key;
+    unsigned int index;
+};
+
+static bool keyedBodyLess(const KeyedBody& a, const KeyedBody& b) {
+    if (a.key != b.key) return a.key < b.key;
+    return a.index < b.index;
+}
+
+static int octant(uint64_t key, int level) {
+    return static_cast<int>((key >> (3 * (MORTON_LEVELS - 1 - level))) & 7);
+}
+
+static void summarizeNode(const BarnesHutTree& tree, BarnesHutNode& node) {
+    double m = 0.0, cx = 0.0, cy = 0.0, cz = 0.0, softening = 0.0;
+    node.lo[0] = node.hi[0] = tree.x[node.begin];
+    node.lo[1] = node.hi[1] = tree.y[node.begin];
+    node.lo[2] = node.hi[2] = tree.z[node.begin];
+    for (unsigned int k = node.begin; k < node.end; ++k) {
+        const double position[3] = { tree.x[k], tree.y[k], tree.z[k] };
+        for (int c = 0; c < 3; ++c) {
+            node.lo[c] = std::min(node.lo[c], position[c]);
+            node.hi[c] = std::max(node.hi[c], position[c]);
+        }
+        m += tree.mass[k];
+        softening = std::max(softening, tree.softening[k]);
+        cx += tree.mass[k] * position[0];
+        cy += tree.mass[k] * position[1];
+        cz += tree.mass[k] * position[2];
+    }
+    node.mass = m;
+    node.softening = softening;
+    node.com[0] = m > 0.0 ? cx / m : node.lo[0];
+    node.com[1] = m > 0.0 ? cy / m : node.lo[1];
+    node.com[2] = m > 0.0 ? cz / m : node.lo[2];
+    double edge = std::max(node.hi[0] - node.lo[0], std::max(node.hi[1] - node.lo[1], node.hi[2] - node.lo[2]));
+    node.size2 = edge * edge;
+}
+
+static void buildNode(BarnesHutTree& tree, const KeyedBody* keys, size_t id, int level) {
+    BarnesHutNode& node = tree.nodes[id];
+    summarizeNode(tree, node);
+    node.firstChild = node.childCount = 0;
+
+    unsigned int begin = node.begin, end = node.end;
+    // Sauter les niveaux où tous les corps partagent l'octant (clés triées : premier et dernier suffisent)
+    while (level < MORTON_LEVELS && octant(keys[begin].key, level) == octant(keys[end - 1].key, level)) {
+        ++level;
+    }
+    if (end - begin <= BARNES_HUT_LEAF || level >= MORTON_LEVELS) {
+        return;
+    }
+
+    unsigned int bounds[9];
+    unsigned int count = 0;
+    bounds[0] = begin;
+    for (unsigned int k = begin + 1; k < end; ++k) {
+        if (octant(keys[k].key, level) != octant(keys[k - 1].key, level)) {
+            bounds[++count] = k;
+        }
+    }
+    bounds[++count] = end;
+
+    node.firstChild = static_cast<unsigned int>(tree.nodeCount);
+    node.childCount = count;
+    tree.nodeCount += count;
+    for (unsigned int c = 0; c < count; ++c) {
+        BarnesHutNode& child = tree.nodes[node.firstChild + c];
+        child.begin = bounds[c];
+        child.end = bounds[c + 1];
+        buildNode(tree, keys, node.firstChild + c, level + 1);
+    }
+}
+
+void buildBarnesHutTree(const double* x, const double* y, const double* z, const double* mass, const double* softening,
+                        size_t n, BarnesHutTree& tree) {
+    Arena& arena = stepArena();
+    tree.bodyCount = n;
+    tree.nodeCount = 0;
+    if (n == 0) {
+        return;
+    }
+
+    double lo[3] = { x[0], y[0], z[0] };
+    double hi[3] = { lo[0], lo[1], lo[2] };
+    for (size_t k = 0; k < n; ++k) {
+        const double position[3] = { x[k], y[k], z[k] };
+        for (int c = 0; c < 3; ++c) {
+            lo[c] = std::min(lo[c], position[c]);
+            hi[c] = std::max(hi[c], position[c]);
+        }
+    }
+    // Même échelle sur les trois axes : les octants restent des cubes
+    double extent = std::max(hi[0] - lo[0], std::max(hi[1] - lo[1], hi[2] - lo[2]));
+    double s = extent > 0.0 ? MORTON_CELLS / extent : 0.0;
+    const double scale[3] = { s, s, s };
+
+    KeyedBody* keys = arena.allocateArray<KeyedBody>(n);
+    for (size_t k = 0; k < n; ++k) {
+        keys[k].key = mortonKey(x[k], y[k], z[k], lo, scale);
+        keys[k].index = static_cast<unsigned int>(k);
+    }
+    std::sort(keys, keys + n, keyedBodyLess);
+
+    tree.order = arena.allocateArray<unsigned int>(n);
+    tree.x = arena.allocateArray<double>(n);
+    tree.y = arena.allocateArray<double>(n);
+    tree.z = arena.allocateArray<double>(n);
+    tree.mass = arena.allocateArray<double>(n);
+    tree.softening = arena.allocateArray<double>(n);
+    for (size_t k = 0; k < n; ++k) {
+        unsigned int index = keys[k].index;
+        tree.order[k] = index;
+        tree.x[k] = x[index];
+        tree.y[k] = y[index];
+        tree.z[k] = z[index];
+        tree.mass[k] = mass[index];
+        tree.softening[k] = softening[index];
+    }
+
+    // Chaque nœud interne a au moins deux enfants : au plus n feuilles et n - 1 nœuds internes
+    tree.nodes = arena.allocateArray<BarnesHutNode>(2 * n);
+    tree.nodeCount = 1;
+    tree.nodes[0].begin = 0;
+    tree.nodes[0].end = static_cast<unsigned int>(n);
+    buildNode(tree, keys, 0, 0);
+}
+
+void buildBarnesHutTree(const std::vector<Planet>& planets, BarnesHutTree& tree) {
+    size_t n = planets.size();
+    Arena& arena = stepArena();
+    double* x = arena.allocateArray<double>(n);
+    double* y = arena.allocateArray<double>(n);
+    double* z = arena.allocateArray<double>(n);
+    double* mass = arena.allocateArray<double>(n);
+    double* softening = arena.allocateArray<double>(n);
+    for (size_t k = 0; k < n; ++k) {
+        x[k] = planets[k].x;
+        y[k] = planets[k].y;
+        z[k] = planets[k].z;
+        mass[k] = planets[k].mass;
+        softening[k] = planets[k].softening;
+    }
+    buildBarnesHutTree(x, y, z, mass, softening, n, tree);
+}
+
+// Même loi que computeGravitationalForce ; le noyau historique garde exactement ses opérations
+static inline void accumulate(double dx, double dy, double dz, double mass, double epsilon, SofteningKernel kernel,
+                              double& ax, double& ay, double& az) {
+    double factor;
+    if (kernel == SOFTENING_CLAMP) {
+        double dist = sqrt(dx*dx + dy*dy + dz*dz);
+        if (dist < epsilon) {
+            dist = epsilon;
+        }
+        factor = G * mass / (dist * dist * dist);
+    } else {
+        factor = G * mass * softenedForceFactor(kernel, dx*dx + dy*dy + dz*dz, epsilon);
+    }
+    ax += factor * dx;
+    ay += factor * dy;
+    az += factor * dz;
+}
+
+// Accélération du k-ième corps de l'ordre de Morton ; renvoie le nombre d'interactions calculées
+// phi, si non nul, reçoit le potentiel au corps divisé par -G (somme des masses sur les distances adoucies)
+static unsigned int traverse(const BarnesHutTree& tree, size_t i, double theta2, SofteningKernel kernel,
+                             double& ax, double& ay, double& az, double* phi) {
+    unsigned int stack[TRAVERSAL_STACK];
+    unsigned int interactions = 0;
+    double px = tree.x[i], py = tree.y[i], pz = tree.z[i], own = tree.softening[i];
+    ax = ay = az = 0.0;
+    int top = 0;
+    stack[top++] = 0;
+    while (top > 0) {
+        const BarnesHutNode& node = tree.nodes[stack[--top]];
+        if (node.childCount == 0) {
+            for (unsigned int j = node.begin; j < node.end; ++j) {
+                if (j != i) {
+                    double dx = tree.x[j] - px, dy = tree.y[j] - py, dz = tree.z[j] - pz;
+                    double epsilon = pairSoftening(own, tree.softening[j]);
+                    accumulate(dx, dy, dz, tree.mass[j], epsilon, kernel, ax, ay, az);
+                    if (phi) {
+                        *phi += tree.mass[j] * softenedPotential(kernel, dx*dx + dy*dy + dz*dz, epsilon);
+                    }
+                }
+            }
+            interactions += node.end - node.begin;
+            continue;
+        }
+        // Distance au point le plus proche de la boîte, et non au centre de masse : un membre
+        // du nœud peut être bien plus proche que son centre de masse (nulle si le corps est dedans)
+        double gx = std::max(0.0, std::max(node.lo[0] - px, px - node.hi[0]));
+        double gy = std::max(0.0, std::max(node.lo[1] - py, py - node.hi[1]));
+        double gz = std::max(0.0, std::max(node.lo[2] - pz, pz - node.hi[2]));
+        if (node.size2 < theta2 * (gx*gx + gy*gy + gz*gz)) {
+            double dx = node.com[0] - px, dy = node.com[1] - py, dz = node.com[2] - pz;
+            double epsilon = pairSoftening(own, node.softening);
+            accumulate(dx, dy, dz, node.mass, epsilon, kernel, ax, ay, az);
+            if (phi) {
+                *phi += node.mass * softenedPotential(kernel, dx*dx + dy*dy + dz*dz, epsilon);
+            }
+            ++interactions;
+            continue;
+        }
+        for (unsigned int c = 0; c < node.childCount; ++c) {
+            stack[top++] = node.firstChild + c;
+        }
+    }
+    return interactions;
+}
+
+void barnesHutForces(const BarnesHutTree& tree, std::vector<Planet>& planets, size_t begin, size_t end, double theta,
+                     double* potential) {
+    if (tree.nodeCount == 0) {
+        return;
+    }
+    const double theta2 = theta * theta;
+    SofteningKernel kernel = softeningKernel();
+    double energy = 0.0;
+    for (size_t i = begin; i < end; ++i) {
+        double ax, ay, az, phi = 0.0;
+        traverse(tree, i, theta2, kernel, ax, ay, az, potential ? &phi : nullptr);
+        Planet& p = planets[tree.order[i]];
+        p.ax += ax;
+        p.ay += ay;
+        p.az += az;
+        energy -= 0.5 * G * tree.mass[i] * phi; // Chaque paire est comptée depuis ses deux corps
+    }
+    if (potential) {
+        *potential = energy;
+    }
+}
+
+void barnesHutAccelerations(const BarnesHutTree& tree, size_t begin, size_t end, double theta, size_t targets,
+                            double* ax, double* ay, double* az, unsigned int* interactions) {
+    if (tree.nodeCount == 0) {
+        return;
+    }
+    const double theta2 = theta * theta;
+    SofteningKernel kernel = softeningKernel();
+    for (size_t i = begin; i < end; ++i) {
+        unsigned int index = tree.order[i];
+        if (index >= targets) {
+            continue;
+        }
+        double bx, by, bz;
+        unsigned int count = traverse(tree, i, theta2, kernel, bx, by, bz, nullptr);
+        ax[index] += bx;
+        ay[index] += by;
+        az[index] += bz;
+        if (interactions) {
+            interactions[index] = count;
+        }
+    }
+}
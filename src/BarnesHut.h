@@ -0,0 +1,54 @@
+// BarnesHut.h
+#ifndef BARNES_HUT_H
+#define BARNES_HUT_H
+
+#include <cstddef>
+#include <vector>
+#include "Planet.h"
+
+const size_t BARNES_HUT_LEAF = 8;   // Corps au plus par feuille, sommés directement
+const size_t BARNES_HUT_TILE = 256; // Corps consécutifs (ordre de Morton) par tâche de forces
+
+struct BarnesHutNode {
+    double lo[3], hi[3]; // Boîte englobante serrée des corps du nœud
+    double com[3];       // Centre de masse
+    double mass;
+    double softening;    // Plus grande longueur d'adoucissement des corps du nœud
+    double size2;        // Carré de la plus grande arête, pour le critère d'ouverture
+    unsigned int begin, end;             // Corps du nœud, dans l'ordre de Morton
+    unsigned int firstChild, childCount; // Enfants contigus ; aucun pour une feuille
+};
+
+// Octree compressé construit sur les clés de Morton : un niveau où tous les corps tombent
+// dans le même octant ne crée pas de nœud, d'où au plus 2n nœuds. Tous les tableaux sont
+// pris dans stepArena() et ne valent que pour le pas en cours.
+struct BarnesHutTree {
+    BarnesHutNode* nodes;
+    size_t nodeCount;
+    unsigned int* order;     // order[k] : indice dans planets du k-ième corps de l'ordre de Morton
+    double* x, * y, * z, * mass; // Positions et masses dans cet ordre, contiguës pour le parcours
+    double* softening;           // Longueurs d'adoucissement, dans le même ordre
+    size_t bodyCount;
+};
+
+void buildBarnesHutTree(const std::vector<Planet>& planets, BarnesHutTree& tree);
+void buildBarnesHutTree(const double* x, const double* y, const double* z, const double* mass, const double* softening,
+                        size_t n, BarnesHutTree& tree);
+
+// Ajoute aux accélérations des corps [begin, end) de l'ordre de Morton la force de tout l'arbre.
+// Un nœud est ouvert si sa taille dépasse theta fois la distance du corps à sa boîte englobante.
+// Forces adoucies par softeningKernel() ; un nœud accepté l'est à sa propre longueur.
+// Chaque corps n'est écrit que par son propre appel : les tuiles peuvent tourner en parallèle,
+// et le résultat ne dépend pas du nombre de threads. potential, si non nul, reçoit la part de
+// l'énergie potentielle de ces corps (la moitié de celle de chacune de leurs interactions).
+void barnesHutForces(const BarnesHutTree& tree, std::vector<Planet>& planets, size_t begin, size_t end, double theta,
+                     double* potential = nullptr);
+
+// Même parcours sur des tableaux indexés comme à la construction. Seuls les corps d'indice
+// inférieur à targets reçoivent une accélération : les suivants ne sont que des sources
+// (corps et pseudo-corps importés d'autres domaines en mode distribué). interactions, si
+// non nul, reçoit le nombre de termes calculés pour chaque corps (coût pour l'équilibrage).
+void barnesHutAccelerations(const BarnesHutTree& tree, size_t begin, size_t end, double theta, size_t targets,
+                            double* ax, double* ay, double* az, unsigned int* interactions);
+
+#endif // BARNES_HUT_H
@@ -0,0 +1,14 @@
+// Camera.h
+#ifndef CAMERA_H
+#define CAMERA_H
+
+// Caméra commune aux chemins de rendu, en unités astronomiques
+struct CameraState {
+    double eye[3];    // Position de la caméra
+    double target[3]; // Point de référence (planète focalisée)
+    double up[3];     // Vecteur "up"
+    double fovy;      // Champ de vision vertical (degrés)
+    double zNear, zFar;
+};
+
+#endif // CAMERA_H
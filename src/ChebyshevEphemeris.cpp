@@ -0,0 +1,367 @@
+// ChebyshevEphemeris.cpp
+#include "ChebyshevEphemeris.h"
+#include "SolarSystem.h"
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// Série de Tchebychev et sa dérivée en x dans [-1, 1] (récurrence sur T et T')
+static void chebyshevSeries(const double* c, int degree, double x, double& value, double& derivative) {
+    double t0 = 1.0, t1 = x, d0 = 0.0, d1 = 1.0;
+    value = c[0];
+    derivative = 0.0;
+    if (degree >= 1) {
+        value += c[1] * x;
+        derivative += c[1];
+    }
+    for (int j = 2; j <= degree; ++j) {
+        double t2 = 2.0 * x * t1 - t0;
+        double d2 = 2.0 * t1 + 2.0 * x * d1 - d0;
+        value += c[j] * t2;
+        derivative += c[j] * d2;
+        t0 = t1; t1 = t2;
+        d0 = d1; d1 = d2;
+    }
+}
+
+// Position à l'instant t par interpolation de Lagrange cubique sur quatre échantillons voisins.
+// Les vitesses enregistrées ne servent pas : avec le schéma d'Euler semi-implicite, elles sont décalées
+// d'un demi-pas par rapport à la pente des positions, ce qui ferait osciller une interpolation d'Hermite.
+static void samplePosition(const EphemerisReader& input, size_t body, double t, double position[3]) {
+    size_t count = input.sampleCount();
+    if (count < 4) {
+        double state[6];
+        input.evaluateBody(t, body, state);
+        position[0] = state[0]; position[1] = state[1]; position[2] = state[2];
+        return;
+    }
+    size_t k = input.findSample(t);
+    size_t first = k > 0 ? k - 1 : 0;
+    if (first + 4 > count) {
+        first = count - 4;
+    }
+    double times[4];
+    for (int i = 0; i < 4; ++i) {
+        times[i] = input.time(first + i);
+    }
+    position[0] = position[1] = position[2] = 0.0;
+    for (int i = 0; i < 4; ++i) {
+        double weight = 1.0;
+        for (int j = 0; j < 4; ++j) {
+            if (j != i) {
+                weight *= (t - times[j]) / (times[i] - times[j]);
+            }
+        }
+        const double* state = input.sampleState(first + i, body);
+        position[0] += weight * state[0];
+        position[1] += weight * state[1];
+        position[2] += weight * state[2];
+    }
+}
+
+// Interpolation aux nœuds de Tchebychev-Gauss : coefficients de degré maxDegree pour chaque coordonnée
+static void fitWindow(const EphemerisReader& input, size_t body, double start, double length, int maxDegree,
+                      std::vector<double>& coefficients) {
+    int n = maxDegree + 1;
+    std::vector<double> values(3 * n);
+    for (int k = 0; k < n; ++k) {
+        double x = cos(M_PI * (k + 0.5) / n);
+        double position[3];
+        samplePosition(input, body, start + (x + 1.0) * 0.5 * length, position);
+        for (int c = 0; c < 3; ++c) {
+            values[c * n + k] = position[c];
+        }
+    }
+    coefficients.assign(3 * n, 0.0);
+    for (int c = 0; c < 3; ++c) {
+        for (int j = 0; j < n; ++j) {
+            double sum = 0.0;
+            for (int k = 0; k < n; ++k) {
+                sum += values[c * n + k] * cos(M_PI * j * (k + 0.5) / n);
+            }
+            coefficients[c * n + j] = (j == 0 ? 1.0 : 2.0) * sum / n;
+        }
+    }
+}
+
+// Plus grand écart, sur les échantillons de la fenêtre, de la série tronquée au degré donné
+static double windowError(const EphemerisReader& input, size_t body, double start, double length,
+                          const std::vector<double>& coefficients, int maxDegree, int degree) {
+    int n = maxDegree + 1;
+    double worst = 0.0;
+    size_t first = input.findSample(start);
+    for (size_t sample = first; sample < input.sampleCount(); ++sample) {
+        double t = input.time(sample);
+        if (t < start) continue;
+        if (t > start + length) break;
+        double x = 2.0 * (t - start) / length - 1.0;
+        const double* state = input.sampleState(sample, body);
+        double error2 = 0.0;
+        for (int c = 0; c < 3; ++c) {
+            double value, derivative;
+            chebyshevSeries(&coefficients[c * n], degree, x, value, derivative);
+            error2 += (value - state[c]) * (value - state[c]);
+        }
+        worst = std::max(worst, sqrt(error2));
+    }
+    return worst;
+}
+
+// Choisit pour un corps la durée de fenêtre et le plus petit degré commun qui tiennent la tolérance
+static void fitBody(const EphemerisReader& input, size_t body, const ChebyshevFitOptions& fit,
+                    ChebyshevBody& segment, std::vector<double>& packed, double& maxError) {
+    double start = input.startTime(), span = input.endTime() - start;
+    double spacing = input.sampleCount() > 1 ? span / (input.sampleCount() - 1) : span;
+    double window = fit.window;
+    std::vector<std::vector<double> > windows;
+    std::vector<int> degrees;
+
+    for (;;) {
+        size_t count = span > 0.0 ? static_cast<size_t>(ceil(span / window)) : 1;
+        double length = span > 0.0 ? span / count : 1.0; // Fenêtres de même durée couvrant exactement l'intervalle
+        windows.assign(count, std::vector<double>());
+        degrees.assign(count, fit.maxDegree);
+        bool withinTolerance = true;
+        for (size_t w = 0; w < count; ++w) {
+            double windowStart = start + w * length;
+            fitWindow(input, body, windowStart, length, fit.maxDegree, windows[w]);
+            if (windowError(input, body, windowStart, length, windows[w], fit.maxDegree, fit.maxDegree) > fit.tolerance) {
+                withinTolerance = false;
+                break;
+            }
+            // Dichotomie sur le degré : l'erreur de la série tronquée décroît avec le degré
+            int lo = 0, hi = fit.maxDegree;
+            while (lo < hi) {
+                int mid = (lo + hi) / 2;
+                if (windowError(input, body, windowStart, length, windows[w], fit.maxDegree, mid) <= fit.tolerance) {
+                    hi = mid;
+                } else {
+                    lo = mid + 1;
+                }
+            }
+            degrees[w] = lo;
+        }
+        // Arrêt si la tolérance est tenue ou si les fenêtres ne contiennent presque plus d'échantillons
+        if (withinTolerance || length < 4.0 * spacing) {
+            segment.windowLength = length;
+            segment.windowCount = static_cast<uint32_t>(count);
+            if (!withinTolerance) {
+                for (size_t w = 0; w < count; ++w) {
+                    if (windows[w].empty()) {
+                        fitWindow(input, body, start + w * length, length, fit.maxDegree, windows[w]);
+                    }
+                }
+            }
+            break;
+        }
+        window = length * 0.5;
+    }
+
+    int degree = 0;
+    for (int d : degrees) {
+        degree = std::max(degree, d);
+    }
+    segment.degree = static_cast<uint32_t>(degree);
+    segment.offset = packed.size();
+    int n = fit.maxDegree + 1;
+    for (size_t w = 0; w < segment.windowCount; ++w) {
+        for (int c = 0; c < 3; ++c) {
+            packed.insert(packed.end(), windows[w].begin() + c * n, windows[w].begin() + c * n + degree + 1);
+        }
+        maxError = std::max(maxError, windowError(input, body, input.startTime() + w * segment.windowLength,
+                                                   segment.windowLength, windows[w], fit.maxDegree, degree));
+    }
+}
+
+bool compressEphemeris(const EphemerisReader& input, const char* outputPath, const ChebyshevFitOptions& fit,
+                       ChebyshevFitReport& report) {
+    size_t n = input.bodyCount();
+    std::vector<ChebyshevBody> segments(n);
+    std::vector<double> packed;
+    report.maxError = 0.0;
+    for (size_t body = 0; body < n; ++body) {
+        segments[body].info = input.body(body);
+        fitBody(input, body, fit, segments[body], packed, report.maxError);
+    }
+
+    FILE* file = fopen(outputPath, "wb");
+    if (!file) {
+        std::cerr << "Failed to open ephemeris file: " << outputPath << std::endl;
+        return false;
+    }
+    ChebyshevHeader header;
+    memcpy(header.magic, CHEBYSHEV_MAGIC, sizeof(header.magic));
+    header.version = CHEBYSHEV_VERSION;
+    header.bodyCount = static_cast<uint32_t>(n);
+    header.startTime = input.startTime();
+    header.endTime = input.endTime();
+    bool ok = fwrite(&header, sizeof(header), 1, file) == 1 &&
+              fwrite(segments.data(), sizeof(ChebyshevBody), n, file) == n &&
+              fwrite(packed.data(), sizeof(double), packed.size(), file) == packed.size();
+    fclose(file);
+    if (!ok) {
+        std::cerr << "Failed to write ephemeris file: " << outputPath << std::endl;
+        return false;
+    }
+
+    report.inputBytes = sizeof(EphemerisHeader) + n * sizeof(EphemerisBody) +
+                        input.sampleCount() * (1 + 6 * n) * sizeof(double);
+    report.outputBytes = sizeof(header) + n * sizeof(ChebyshevBody) + packed.size() * sizeof(double);
+    return true;
+}
+
+ChebyshevEphemeris::ChebyshevEphemeris()
+    : mapping(nullptr), mappingSize(0), header(nullptr), bodies(nullptr), coefficients(nullptr) {
+}
+
+bool ChebyshevEphemeris::open(const char* path) {
+    int fd = ::open(path, O_RDONLY);
+    if (fd < 0) {
+        std::cerr << "Failed to open ephemeris file: " << path << std::endl;
+        return false;
+    }
+    struct stat info;
+    if (fstat(fd, &info) != 0 || static_cast<size_t>(info.st_size) < sizeof(ChebyshevHeader)) {
+        std::cerr << "Invalid ephemeris file: " << path << std::endl;
+        ::close(fd);
+        return false;
+    }
+    mappingSize = static_cast<size_t>(info.st_size);
+    mapping = mmap(nullptr, mappingSize, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (mapping == MAP_FAILED) {
+        std::cerr << "Failed to map ephemeris file: " << path << std::endl;
+        mapping = nullptr;
+        return false;
+    }
+
+    const unsigned char* base = static_cast<const unsigned char*>(mapping);
+    header = reinterpret_cast<const ChebyshevHeader*>(base);
+    size_t bodiesEnd = sizeof(ChebyshevHeader) + header->bodyCount * sizeof(ChebyshevBody);
+    bool valid = memcmp(header->magic, CHEBYSHEV_MAGIC, sizeof(header->magic)) == 0 &&
+                 header->version == CHEBYSHEV_VERSION && header->bodyCount > 0 && bodiesEnd <= mappingSize;
+    if (valid) {
+        bodies = reinterpret_cast<const ChebyshevBody*>(base + sizeof(ChebyshevHeader));
+        coefficients = reinterpret_cast<const double*>(base + bodiesEnd);
+        size_t available = (mappingSize - bodiesEnd) / sizeof(double);
+        for (size_t k = 0; k < header->bodyCount && valid; ++k) {
+            const ChebyshevBody& segment = bodies[k];
+            valid = segment.windowCount > 0 && segment.windowLength > 0.0 &&
+                    segment.offset + static_cast<uint64_t>(segment.windowCount) * 3 * (segment.degree + 1) <= available;
+        }
+    }
+    if (!valid) {
+        std::cerr << "Invalid ephemeris file: " << path << std::endl;
+        close();
+        return false;
+    }
+    return true;
+}
+
+void ChebyshevEphemeris::close() {
+    if (mapping) {
+        munmap(mapping, mappingSize);
+    }
+    mapping = nullptr;
+    mappingSize = 0;
+    header = nullptr;
+    bodies = nullptr;
+    coefficients = nullptr;
+}
+
+bool ChebyshevEphemeris::isOpen() const {
+    return mapping != nullptr;
+}
+
+size_t ChebyshevEphemeris::bodyCount() const {
+    return header ? header->bodyCount : 0;
+}
+
+const EphemerisBody& ChebyshevEphemeris::body(size_t index) const {
+    return bodies[index].info;
+}
+
+const ChebyshevBody& ChebyshevEphemeris::segment(size_t index) const {
+    return bodies[index];
+}
+
+double ChebyshevEphemeris::startTime() const {
+    return header->startTime;
+}
+
+double ChebyshevEphemeris::endTime() const {
+    return header->endTime;
+}
+
+void ChebyshevEphemeris::evaluateBody(double t, size_t body, double position[3], double velocity[3]) const {
+    const ChebyshevBody& segment = bodies[body];
+    double offset = t - header->startTime;
+    if (offset < 0.0) offset = 0.0;
+    size_t window = static_cast<size_t>(offset / segment.windowLength);
+    if (window >= segment.windowCount) {
+        window = segment.windowCount - 1; // Fin de l'intervalle
+    }
+    double x = 2.0 * (offset - window * segment.windowLength) / segment.windowLength - 1.0;
+    if (x > 1.0) x = 1.0;
+
+    int degree = static_cast<int>(segment.degree);
+    const double* c = coefficients + segment.offset + window * 3 * (degree + 1);
+    for (int axis = 0; axis < 3; ++axis) {
+        double value, derivative;
+        chebyshevSeries(c + axis * (degree + 1), degree, x, value, derivative);
+        position[axis] = value;
+        if (velocity) {
+            velocity[axis] = derivative * 2.0 / segment.windowLength;
+        }
+    }
+}
+
+void ChebyshevEphemeris::evaluate(double t, std::vector<double>& states) const {
+    size_t n = bodyCount();
+    states.resize(6 * n);
+    for (size_t body = 0; body < n; ++body) {
+        evaluateBody(t, body, &states[6 * body], &states[6 * body + 3]);
+    }
+}
+
+bool isChebyshevEphemeris(const char* path) {
+    char magic[8];
+    FILE* file = fopen(path, "rb");
+    if (!file) {
+        return false;
+    }
+    bool match = fread(magic, 1, sizeof(magic), file) == sizeof(magic) && memcmp(magic, CHEBYSHEV_MAGIC, sizeof(magic)) == 0;
+    fclose(file);
+    return match;
+}
+
+int runEphemerisCompression(const SimulationOptions& options) {
+    if (!options.playbackPath) {
+        std::cerr << "--compress-ephemeris needs the sampled input file given with --playback" << std::endl;
+        return -1;
+    }
+    EphemerisReader input;
+    if (!input.open(options.playbackPath)) {
+        return -1;
+    }
+    ChebyshevFitOptions fit;
+    fit.tolerance = options.chebyshevTolerance;
+    fit.window = options.chebyshevWindow * DAY;
+    fit.maxDegree = options.chebyshevDegree;
+
+    ChebyshevFitReport report;
+    bool ok = compressEphemeris(input, options.compressOutput, fit, report);
+    input.close();
+    if (!ok) {
+        return -1;
+    }
+    std::cerr << "Ephemeris: " << report.inputBytes << " -> " << report.outputBytes << " bytes ("
+              << static_cast<double>(report.inputBytes) / report.outputBytes << "x), max error "
+              << report.maxError << " m" << std::endl;
+    return 0;
+}
@@ -0,0 +1,86 @@
+// ChebyshevEphemeris.h
+#ifndef CHEBYSHEV_EPHEMERIS_H
+#define CHEBYSHEV_EPHEMERIS_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "Ephemeris.h"
+#include "Options.h"
+
+// Éphémérides compressées, à la manière des segments SPK du JPL : pour chaque corps, l'intervalle
+// enregistré est découpé en fenêtres de même durée, et chaque coordonnée y est approchée par une série
+// de Tchebychev de degré fixe. Trouver la fenêtre d'un instant est une simple division (accès en O(1)) ;
+// la vitesse est la dérivée de la série.
+const char CHEBYSHEV_MAGIC[8] = { 'S', 'S', 'C', 'H', 'E', 'B', '\0', '\0' };
+const uint32_t CHEBYSHEV_VERSION = 1;
+
+struct ChebyshevHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t bodyCount;
+    double startTime; // En secondes
+    double endTime;
+};
+
+// Suivi dans le fichier, pour chaque corps, de ses coefficients : windowCount fenêtres de
+// 3 * (degree + 1) valeurs (x, puis y, puis z), à partir de offset (en nombre de doubles)
+struct ChebyshevBody {
+    EphemerisBody info;
+    double windowLength; // En secondes
+    uint32_t degree;
+    uint32_t windowCount;
+    uint64_t offset;
+};
+
+struct ChebyshevFitOptions {
+    double tolerance;   // Écart maximal toléré avec les échantillons (en mètres)
+    double window;      // Durée initiale des fenêtres, divisée par deux tant que la tolérance n'est pas tenue
+    int maxDegree;
+};
+
+struct ChebyshevFitReport {
+    size_t inputBytes, outputBytes;
+    double maxError; // Plus grand écart mesuré avec les échantillons (en mètres)
+};
+
+// Ajuste les séries sur un fichier échantillonné et écrit le fichier compressé
+bool compressEphemeris(const EphemerisReader& input, const char* outputPath, const ChebyshevFitOptions& fit,
+                       ChebyshevFitReport& report);
+
+// Lecture par projection en mémoire, même interface d'évaluation que EphemerisReader
+class ChebyshevEphemeris {
+public:
+    ChebyshevEphemeris();
+
+    bool open(const char* path);
+    void close();
+    bool isOpen() const;
+
+    size_t bodyCount() const;
+    const EphemerisBody& body(size_t index) const;
+    const ChebyshevBody& segment(size_t index) const;
+    double startTime() const;
+    double endTime() const;
+
+    // Position (et vitesse si velocity n'est pas nul) d'un corps ; t est borné à l'intervalle couvert
+    void evaluateBody(double t, size_t body, double position[3], double velocity[3]) const;
+
+    // 6 valeurs par corps (x, y, z, vx, vy, vz), comme EphemerisReader::evaluate
+    void evaluate(double t, std::vector<double>& states) const;
+
+private:
+    void* mapping;
+    size_t mappingSize;
+    const ChebyshevHeader* header;
+    const ChebyshevBody* bodies;
+    const double* coefficients;
+};
+
+// Vrai si le fichier commence par l'en-tête des éphémérides compressées
+bool isChebyshevEphemeris(const char* path);
+
+// Mode --compress-ephemeris : compresse le fichier de --playback et affiche le bilan
+int runEphemerisCompression(const SimulationOptions& options);
+
+#endif // CHEBYSHEV_EPHEMERIS_H
@@ -0,0 +1,252 @@
+// Collision.cpp
+#include "Collision.h"
+#include "Arena.h"
+#include <algorithm>
+#include <cmath>
+
+struct SweepEntry {
+    double lo, hi; // Intervalle balayé sur l'axe de tri (rayon compris)
+    size_t index;
+};
+
+static bool sweepEntryLess(const SweepEntry& a, const SweepEntry& b) {
+    return a.lo < b.lo;
+}
+
+static bool collisionPairLess(const CollisionPair& a, const CollisionPair& b) {
+    if (a.t != b.t) return a.t < b.t;
+    if (a.i != b.i) return a.i < b.i;
+    return a.j < b.j;
+}
+
+static double axisPosition(const Planet& p, int axis) {
+    return axis == 0 ? p.x : (axis == 1 ? p.y : p.z);
+}
+
+static double axisVelocity(const Planet& p, int axis) {
+    return axis == 0 ? p.vx : (axis == 1 ? p.vy : p.vz);
+}
+
+int sweepAxis(const std::vector<Planet>& planets) {
+    double mean[3] = { 0.0, 0.0, 0.0 };
+    double sq[3] = { 0.0, 0.0, 0.0 };
+    for (const auto& p : planets) {
+        for (int a = 0; a < 3; ++a) {
+            double c = axisPosition(p, a);
+            mean[a] += c;
+            sq[a] += c * c;
+        }
+    }
+    int best = 0;
+    double bestVariance = -1.0;
+    double n = static_cast<double>(planets.size());
+    for (int a = 0; a < 3; ++a) {
+        double variance = sq[a] / n - (mean[a] / n) * (mean[a] / n);
+        if (variance > bestVariance) {
+            bestVariance = variance;
+            best = a;
+        }
+    }
+    return best;
+}
+
+// Test continu : les deux sphères se déplacent en ligne droite pendant le dernier pas.
+// Retourne l'instant du premier contact (fraction de dt) dans t.
+static bool sweptSphereContact(const Planet& a, const Planet& b, double dt, double& t) {
+    double R = a.radius + b.radius;
+
+    // Déplacement relatif pendant le pas et position relative au début du pas
+    double wx = (b.vx - a.vx) * dt;
+    double wy = (b.vy - a.vy) * dt;
+    double wz = (b.vz - a.vz) * dt;
+    double sx = (b.x - a.x) - wx;
+    double sy = (b.y - a.y) - wy;
+    double sz = (b.z - a.z) - wz;
+
+    double c = sx*sx + sy*sy + sz*sz - R*R;
+    if (c <= 0.0) { // Déjà en contact au début du pas
+        t = 0.0;
+        return true;
+    }
+
+    // Résoudre |s + w t|² = R² pour t dans [0, 1]
+    double A = wx*wx + wy*wy + wz*wz;
+    double B = sx*wx + sy*wy + sz*wz;
+    if (A == 0.0 || B >= 0.0) { // Pas de mouvement relatif, ou les corps s'éloignent
+        return false;
+    }
+    double disc = B*B - A*c;
+    if (disc < 0.0) {
+        return false;
+    }
+    double root = (-B - sqrt(disc)) / A;
+    if (root > 1.0) {
+        return false;
+    }
+    t = root;
+    return true;
+}
+
+void detectCollisions(const std::vector<Planet>& planets, double dt, std::vector<CollisionPair>& pairs) {
+    pairs.clear();
+    size_t n = planets.size();
+    if (n < 2) {
+        return;
+    }
+
+    int axis = sweepAxis(planets);
+    SweepEntry* entries = stepArena().allocateArray<SweepEntry>(n);
+    for (size_t i = 0; i < n; ++i) {
+        const Planet& p = planets[i];
+        double end = axisPosition(p, axis);
+        double start = end - axisVelocity(p, axis) * dt;
+        entries[i].lo = std::min(start, end) - p.radius;
+        entries[i].hi = std::max(start, end) + p.radius;
+        entries[i].index = i;
+    }
+    std::sort(entries, entries + n, sweepEntryLess);
+
+    // Seules les paires dont les intervalles se recouvrent passent au test précis
+    for (size_t a = 0; a < n; ++a) {
+        for (size_t b = a + 1; b < n && entries[b].lo <= entries[a].hi; ++b) {
+            size_t i = std::min(entries[a].index, entries[b].index);
+            size_t j = std::max(entries[a].index, entries[b].index);
+            double t;
+            if (sweptSphereContact(planets[i], planets[j], dt, t)) {
+                CollisionPair pair = { i, j, t };
+                pairs.push_back(pair);
+            }
+        }
+    }
+    std::sort(pairs.begin(), pairs.end(), collisionPairLess);
+}
+
+// Fusion parfaite au moment du contact ; le corps le plus massif conserve son identité
+static void mergeBodies(Planet& a, Planet& b, double back) {
+    Planet& keep = a.mass >= b.mass ? a : b;
+
+    double m = a.mass + b.mass;
+    double cx = (a.mass * (a.x - a.vx * back) + b.mass * (b.x - b.vx * back)) / m;
+    double cy = (a.mass * (a.y - a.vy * back) + b.mass * (b.y - b.vy * back)) / m;
+    double cz = (a.mass * (a.z - a.vz * back) + b.mass * (b.z - b.vz * back)) / m;
+    double vx = (a.mass * a.vx + b.mass * b.vx) / m;
+    double vy = (a.mass * a.vy + b.mass * b.vy) / m;
+    double vz = (a.mass * a.vz + b.mass * b.vz) / m;
+    double radius = cbrt(a.radius * a.radius * a.radius + b.radius * b.radius * b.radius); // Volume conservé
+
+    keep.mass = m;
+    keep.radius = radius;
+    keep.vx = vx;
+    keep.vy = vy;
+    keep.vz = vz;
+    keep.x = cx + vx * back; // Avancer jusqu'à la fin du pas
+    keep.y = cy + vy * back;
+    keep.z = cz + vz * back;
+}
+
+// Rebond le long de la normale de contact, puis avance jusqu'à la fin du pas
+static void bounceBodies(Planet& a, Planet& b, double back, double restitution) {
+    double pax = a.x - a.vx * back, pay = a.y - a.vy * back, paz = a.z - a.vz * back;
+    double pbx = b.x - b.vx * back, pby = b.y - b.vy * back, pbz = b.z - b.vz * back;
+
+    double nx = pbx - pax, ny = pby - pay, nz = pbz - paz;
+    double dist = sqrt(nx*nx + ny*ny + nz*nz);
+    if (dist == 0.0) {
+        return; // Normale indéfinie
+    }
+    nx /= dist; ny /= dist; nz /= dist;
+
+    double vn = (b.vx - a.vx) * nx + (b.vy - a.vy) * ny + (b.vz - a.vz) * nz;
+    if (vn < 0.0) { // Les corps se rapprochent
+        double J = -(1.0 + restitution) * vn / (1.0 / a.mass + 1.0 / b.mass);
+        a.vx -= J / a.mass * nx; a.vy -= J / a.mass * ny; a.vz -= J / a.mass * nz;
+        b.vx += J / b.mass * nx; b.vy += J / b.mass * ny; b.vz += J / b.mass * nz;
+    }
+
+    a.x = pax + a.vx * back; a.y = pay + a.vy * back; a.z = paz + a.vz * back;
+    b.x = pbx + b.vx * back; b.y = pby + b.vy * back; b.z = pbz + b.vz * back;
+
+    // Séparer les corps déjà interpénétrés au début du pas, au prorata des masses
+    double overlap = a.radius + b.radius - dist;
+    if (overlap > 0.0) {
+        double wa = b.mass / (a.mass + b.mass);
+        double wb = a.mass / (a.mass + b.mass);
+        a.x -= nx * overlap * wa; a.y -= ny * overlap * wa; a.z -= nz * overlap * wa;
+        b.x += nx * overlap * wb; b.y += ny * overlap * wb; b.z += nz * overlap * wb;
+    }
+}
+
+size_t resolveCollisions(std::vector<Planet>& planets, std::vector<CollisionPair>& pairs, double dt,
+                         CollisionMode mode, double restitution, std::vector<int>& remap) {
+    size_t n = planets.size();
+    remap.resize(n);
+    for (size_t k = 0; k < n; ++k) {
+        remap[k] = static_cast<int>(k);
+    }
+    if (mode == COLLISION_OFF || pairs.empty()) {
+        return 0;
+    }
+
+    Arena& arena = stepArena();
+    char* involved = arena.allocateZeroed<char>(n); // Un seul contact par corps et par pas
+    int* absorbedBy = arena.allocateArray<int>(n);
+    for (size_t k = 0; k < n; ++k) {
+        absorbedBy[k] = -1;
+    }
+    size_t handled = 0;
+    for (const auto& pair : pairs) {
+        if (involved[pair.i] || involved[pair.j]) {
+            continue; // Traité au pas suivant si le contact persiste
+        }
+        involved[pair.i] = involved[pair.j] = 1;
+
+        Planet& a = planets[pair.i];
+        Planet& b = planets[pair.j];
+        double back = (1.0 - pair.t) * dt; // Temps écoulé depuis le contact
+        if (mode == COLLISION_MERGE) {
+            bool keepA = a.mass >= b.mass;
+            mergeBodies(a, b, back);
+            if (keepA) {
+                absorbedBy[pair.j] = static_cast<int>(pair.i);
+            } else {
+                absorbedBy[pair.i] = static_cast<int>(pair.j);
+            }
+        } else {
+            bounceBodies(a, b, back, restitution);
+        }
+        ++handled;
+    }
+
+    if (mode == COLLISION_MERGE) {
+        // Compacter le vecteur en conservant l'ordre des corps restants
+        int* newIndex = arena.allocateArray<int>(n);
+        for (size_t k = 0; k < n; ++k) {
+            newIndex[k] = -1;
+        }
+        size_t w = 0;
+        for (size_t k = 0; k < n; ++k) {
+            if (absorbedBy[k] >= 0) {
+                continue;
+            }
+            newIndex[k] = static_cast<int>(w);
+            if (w != k) {
+                planets[w] = planets[k];
+            }
+            ++w;
+        }
+        planets.erase(planets.begin() + w, planets.end());
+        for (size_t k = 0; k < n; ++k) {
+            remap[k] = absorbedBy[k] >= 0 ? newIndex[absorbedBy[k]] : newIndex[k];
+        }
+    }
+    return handled;
+}
+
+size_t handleCollisions(std::vector<Planet>& planets, double dt, CollisionMode mode, double restitution,
+                        std::vector<int>& remap) {
+    std::vector<CollisionPair> pairs;
+    if (mode != COLLISION_OFF) {
+        detectCollisions(planets, dt, pairs);
+    }
+    return resolveCollisions(planets, pairs, dt, mode, restitution, remap);
+}
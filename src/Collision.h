@@ -0,0 +1,41 @@
+// Collision.h
+#ifndef COLLISION_H
+#define COLLISION_H
+
+#include <vector>
+#include <cstddef>
+#include "Planet.h"
+
+enum CollisionMode {
+    COLLISION_OFF,    // Les corps se traversent (comportement historique)
+    COLLISION_MERGE,  // Fusion parfaite : masse, quantité de mouvement et volume conservés
+    COLLISION_BOUNCE  // Rebond avec coefficient de restitution
+};
+
+struct CollisionPair {
+    size_t i, j; // Indices des deux corps (i < j)
+    double t;    // Instant du contact dans le dernier pas, en fraction de dt (0 = début, 1 = fin)
+};
+
+// Axe de plus grande variance des positions (0 = x, 1 = y, 2 = z) : celui où les intervalles
+// d'un balayage se recouvrent le moins
+int sweepAxis(const std::vector<Planet>& planets);
+
+// Phase large par balayage et élagage (sweep-and-prune) sur l'axe de plus grande dispersion,
+// suivie d'un test sphère-sphère continu sur le déplacement du dernier pas.
+// Doit être appelée juste après Planet::update (la position précédente vaut x - vx * dt).
+// Comme resolveCollisions, prend sa mémoire temporaire dans stepArena() : thread du pas uniquement.
+void detectCollisions(const std::vector<Planet>& planets, double dt, std::vector<CollisionPair>& pairs);
+
+// Applique la réponse aux paires détectées, dans l'ordre chronologique des contacts.
+// En mode fusion, les corps absorbés sont retirés du vecteur ; remap[ancien indice] donne
+// alors le nouvel indice du corps (ou celui du corps qui l'a absorbé).
+// Retourne le nombre de collisions traitées.
+size_t resolveCollisions(std::vector<Planet>& planets, std::vector<CollisionPair>& pairs, double dt,
+                         CollisionMode mode, double restitution, std::vector<int>& remap);
+
+// Détection puis réponse en un seul appel, pour la boucle de simulation
+size_t handleCollisions(std::vector<Planet>& planets, double dt, CollisionMode mode, double restitution,
+                        std::vector<int>& remap);
+
+#endif // COLLISION_H
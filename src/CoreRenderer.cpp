@@ -0,0 +1,566 @@
+// CoreRenderer.cpp
+#include "CoreRenderer.h"
+#include "Arena.h"
+#include "Matrix.h"
+#include "Occlusion.h"
+#include "Profiler.h"
+#include "Shader.h"
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <string>
+
+// Bloc uniforme partagé par tous les programmes (point de liaison 0, disposition std140)
+struct CameraBlock {
+    float viewProjection[16]; // Projection * rotation de la vue (la translation est appliquée sur le CPU)
+    float lightPosition[4];   // Position du Soleil relative à la caméra
+    float lightColor[4];      // rgb, a = lumière ambiante
+    float depthParams[4];     // Profondeur logarithmique : x = 1 / zNear, y = 1 / log2(zFar / zNear + 1)
+};
+
+static const GLuint CAMERA_BINDING = 0;
+
+#define CAMERA_BLOCK_GLSL \
+    "layout(std140) uniform Camera {\n" \
+    "    mat4 viewProjection;\n" \
+    "    vec4 lightPosition;\n" \
+    "    vec4 lightColor;\n" \
+    "    vec4 depthParams;\n" \
+    "};\n"
+
+// Profondeur logarithmique (LOG_DEPTH défini par createDepthProgram) : log2(1 + w / zNear) est
+// interpolé par fragment puis normalisé, d'où une précision relative constante de zNear à zFar
+#define LOG_DEPTH_VERTEX_GLSL \
+    "#ifdef LOG_DEPTH\n" \
+    "out float vLogDepth;\n" \
+    "#define WRITE_LOG_DEPTH() vLogDepth = 1.0 + gl_Position.w * depthParams.x\n" \
+    "#else\n" \
+    "#define WRITE_LOG_DEPTH()\n" \
+    "#endif\n"
+
+#define LOG_DEPTH_FRAGMENT_GLSL \
+    "#ifdef LOG_DEPTH\n" \
+    "in float vLogDepth;\n" \
+    "#define WRITE_LOG_DEPTH() gl_FragDepth = log2(vLogDepth) * depthParams.y\n" \
+    "#else\n" \
+    "#define WRITE_LOG_DEPTH()\n" \
+    "#endif\n"
+
+static const char* sphereVertexSource =
+    "#version 330 core\n"
+    CAMERA_BLOCK_GLSL
+    LOG_DEPTH_VERTEX_GLSL
+    "layout(location = 0) in vec3 position; // Sphère unitaire : la position est aussi la normale\n"
+    "layout(location = 1) in vec2 texCoord;\n"
+    "layout(location = 2) in vec4 instanceCenter;\n"
+    "layout(location = 3) in vec4 instanceColor;\n"
+    "layout(location = 4) in vec4 instanceParams;\n"
+    "out vec3 vPosition;\n"
+    "out vec3 vNormal;\n"
+    "out vec2 vTexCoord;\n"
+    "flat out vec4 vColor;\n"
+    "flat out vec4 vParams;\n"
+    "void main() {\n"
+    "    float c = cos(instanceColor.a);\n"
+    "    float s = sin(instanceColor.a);\n"
+    "    vec3 n = vec3(c * position.x - s * position.y, s * position.x + c * position.y, position.z);\n"
+    "    vPosition = instanceCenter.xyz + n * instanceCenter.w;\n"
+    "    vNormal = n;\n"
+    "    vTexCoord = texCoord;\n"
+    "    vColor = instanceColor;\n"
+    "    vParams = instanceParams;\n"
+    "    gl_Position = viewProjection * vec4(vPosition, 1.0);\n"
+    "    WRITE_LOG_DEPTH();\n"
+    "}\n";
+
+static const char* sphereFragmentSource =
+    "#version 330 core\n"
+    CAMERA_BLOCK_GLSL
+    LOG_DEPTH_FRAGMENT_GLSL
+    "uniform sampler2D diffuseTexture;\n"
+    "in vec3 vPosition;\n"
+    "in vec3 vNormal;\n"
+    "in vec2 vTexCoord;\n"
+    "flat in vec4 vColor;\n"
+    "flat in vec4 vParams;\n"
+    "out vec4 fragColor;\n"
+    "void main() {\n"
+    "    WRITE_LOG_DEPTH();\n"
+    "    vec3 base = vParams.x > 0.5 ? texture(diffuseTexture, vTexCoord).rgb : vColor.rgb;\n"
+    "    if (vParams.y > 0.5) { // Le Soleil éclaire les autres mais n'est pas éclairé\n"
+    "        fragColor = vec4(base, 1.0);\n"
+    "        return;\n"
+    "    }\n"
+    "    vec3 N = normalize(vNormal);\n"
+    "    vec3 L = normalize(lightPosition.xyz - vPosition);\n"
+    "    vec3 H = normalize(L + normalize(-vPosition));\n"
+    "    float diffuse = max(dot(N, L), 0.0);\n"
+    "    float specular = diffuse > 0.0 ? pow(max(dot(N, H), 0.0), 128.0) : 0.0;\n"
+    "    fragColor = vec4(base * (lightColor.a + diffuse * lightColor.rgb) + specular * lightColor.rgb, 1.0);\n"
+    "}\n";
+
+static const char* pointVertexSource =
+    "#version 330 core\n"
+    CAMERA_BLOCK_GLSL
+    LOG_DEPTH_VERTEX_GLSL
+    "layout(location = 2) in vec4 instanceCenter;\n"
+    "layout(location = 3) in vec4 instanceColor;\n"
+    "layout(location = 4) in vec4 instanceParams;\n"
+    "flat out vec3 vColor;\n"
+    "void main() {\n"
+    "    vColor = instanceColor.rgb;\n"
+    "    gl_PointSize = instanceParams.z;\n"
+    "    gl_Position = viewProjection * vec4(instanceCenter.xyz, 1.0);\n"
+    "    WRITE_LOG_DEPTH();\n"
+    "}\n";
+
+static const char* pointFragmentSource =
+    "#version 330 core\n"
+    CAMERA_BLOCK_GLSL
+    LOG_DEPTH_FRAGMENT_GLSL
+    "flat in vec3 vColor;\n"
+    "out vec4 fragColor;\n"
+    "void main() {\n"
+    "    WRITE_LOG_DEPTH();\n"
+    "    vec2 d = gl_PointCoord * 2.0 - 1.0; // Point rond\n"
+    "    if (dot(d, d) > 1.0) discard;\n"
+    "    fragColor = vec4(vColor, 1.0);\n"
+    "}\n";
+
+static const char* ringVertexSource =
+    "#version 330 core\n"
+    CAMERA_BLOCK_GLSL
+    LOG_DEPTH_VERTEX_GLSL
+    "uniform vec3 ringCenter;\n"
+    "layout(location = 0) in vec3 position;\n"
+    "layout(location = 1) in vec2 texCoord;\n"
+    "out vec2 vTexCoord;\n"
+    "void main() {\n"
+    "    vTexCoord = texCoord;\n"
+    "    gl_Position = viewProjection * vec4(ringCenter + position, 1.0);\n"
+    "    WRITE_LOG_DEPTH();\n"
+    "}\n";
+
+static const char* ringFragmentSource =
+    "#version 330 core\n"
+    CAMERA_BLOCK_GLSL
+    LOG_DEPTH_FRAGMENT_GLSL
+    "uniform sampler2D ringTexture;\n"
+    "in vec2 vTexCoord;\n"
+    "out vec4 fragColor;\n"
+    "void main() {\n"
+    "    WRITE_LOG_DEPTH();\n"
+    "    fragColor = texture(ringTexture, vTexCoord);\n"
+    "}\n";
+
+static const char* lineVertexSource =
+    "#version 330 core\n"
+    CAMERA_BLOCK_GLSL
+    LOG_DEPTH_VERTEX_GLSL
+    "layout(location = 0) in vec3 position;\n"
+    "void main() {\n"
+    "    gl_Position = viewProjection * vec4(position, 1.0);\n"
+    "    WRITE_LOG_DEPTH();\n"
+    "}\n";
+
+static const char* lineFragmentSource =
+    "#version 330 core\n"
+    CAMERA_BLOCK_GLSL
+    LOG_DEPTH_FRAGMENT_GLSL
+    "uniform vec4 lineColor;\n"
+    "out vec4 fragColor;\n"
+    "void main() {\n"
+    "    WRITE_LOG_DEPTH();\n"
+    "    fragColor = lineColor;\n"
+    "}\n";
+
+static const int sphereSubdivisions[LOD_POINT] = { 32, 16, 8 }; // Mêmes niveaux que le pipeline fixe
+
+bool CoreRenderer::drawEntryLess(const DrawEntry& a, const DrawEntry& b) {
+    if (a.lod != b.lod) return a.lod < b.lod;
+    if (a.texture != b.texture) return a.texture < b.texture;
+    return a.order < b.order;
+}
+
+bool CoreRenderer::ringEntryLess(const RingEntry& a, const RingEntry& b) {
+    if (a.rings->texture != b.rings->texture) return a.rings->texture < b.rings->texture;
+    return a.rings < b.rings; // Anneaux membres des corps : ordre des corps
+}
+
+// En profondeur logarithmique, LOG_DEPTH est défini juste après la ligne #version
+static GLuint createDepthProgram(const char* vertexSource, const char* fragmentSource, const char* name, DepthMode mode) {
+    if (mode != DEPTH_LOGARITHMIC) {
+        return createProgram(vertexSource, fragmentSource, name);
+    }
+    std::string vertex(vertexSource), fragment(fragmentSource);
+    vertex.insert(vertex.find('\n') + 1, "#define LOG_DEPTH\n");
+    fragment.insert(fragment.find('\n') + 1, "#define LOG_DEPTH\n");
+    return createProgram(vertex.c_str(), fragment.c_str(), name);
+}
+
+static void bindCameraBlock(GLuint program) {
+    GLuint index = glGetUniformBlockIndex(program, "Camera");
+    if (index != GL_INVALID_INDEX) {
+        glUniformBlockBinding(program, index, CAMERA_BINDING);
+    }
+}
+
+CoreRenderer::CoreRenderer()
+    : depthMode(DEPTH_STANDARD), sphereProgram(0), pointProgram(0), ringProgram(0), lineProgram(0), lineColorLocation(-1),
+      ringCenterLocation(-1), cameraUbo(0), instanceVbo(0), ringVao(0), pointVao(0), lineVao(0), lineVbo(0) {
+    for (int l = 0; l < LOD_POINT; ++l) {
+        spheres[l].vao = spheres[l].vbo = spheres[l].ebo = 0;
+        spheres[l].indexCount = 0;
+    }
+}
+
+bool CoreRenderer::init(DepthMode mode) {
+    depthMode = mode;
+    sphereProgram = createDepthProgram(sphereVertexSource, sphereFragmentSource, "sphere", mode);
+    pointProgram = createDepthProgram(pointVertexSource, pointFragmentSource, "point", mode);
+    ringProgram = createDepthProgram(ringVertexSource, ringFragmentSource, "ring", mode);
+    lineProgram = createDepthProgram(lineVertexSource, lineFragmentSource, "line", mode);
+    if (!sphereProgram || !pointProgram || !ringProgram || !lineProgram) {
+        destroy();
+        return false;
+    }
+
+    GLuint programs[4] = { sphereProgram, pointProgram, ringProgram, lineProgram };
+    for (GLuint program : programs) {
+        bindCameraBlock(program);
+    }
+    glUseProgram(sphereProgram);
+    glUniform1i(glGetUniformLocation(sphereProgram, "diffuseTexture"), 0);
+    glUseProgram(ringProgram);
+    glUniform1i(glGetUniformLocation(ringProgram, "ringTexture"), 0);
+    ringCenterLocation = glGetUniformLocation(ringProgram, "ringCenter");
+    lineColorLocation = glGetUniformLocation(lineProgram, "lineColor");
+    glUseProgram(0);
+
+    glGenBuffers(1, &cameraUbo);
+    glBindBuffer(GL_UNIFORM_BUFFER, cameraUbo);
+    glBufferData(GL_UNIFORM_BUFFER, sizeof(CameraBlock), nullptr, GL_DYNAMIC_DRAW);
+    glBindBufferBase(GL_UNIFORM_BUFFER, CAMERA_BINDING, cameraUbo);
+    glBindBuffer(GL_UNIFORM_BUFFER, 0);
+
+    glGenBuffers(1, &instanceVbo);
+    for (int l = 0; l < LOD_POINT; ++l) {
+        createSphereMesh(spheres[l], sphereSubdivisions[l], sphereSubdivisions[l]);
+    }
+
+    glGenVertexArrays(1, &ringVao);
+    glBindVertexArray(ringVao);
+    glEnableVertexAttribArray(0);
+    glEnableVertexAttribArray(1);
+    glBindVertexArray(0);
+
+    // Les points lisent directement le tampon d'instances, un sommet par corps
+    glGenVertexArrays(1, &pointVao);
+    bindInstanceAttributes(pointVao, 0, 0);
+
+    glGenVertexArrays(1, &lineVao);
+    glGenBuffers(1, &lineVbo);
+    glBindVertexArray(lineVao);
+    glBindBuffer(GL_ARRAY_BUFFER, lineVbo);
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 3 * sizeof(float), nullptr);
+    glBindVertexArray(0);
+
+    glEnable(GL_DEPTH_TEST);
+    glEnable(GL_PROGRAM_POINT_SIZE);
+    return true;
+}
+
+// Même paramétrage que gluSphere : pôles sur l'axe Z, s le long des méridiens, t de bas en haut
+void CoreRenderer::createSphereMesh(Mesh& mesh, int slices, int stacks) {
+    std::vector<float> vertices;
+    std::vector<GLushort> indices;
+    for (int i = 0; i <= stacks; ++i) {
+        double rho = M_PI * i / stacks;
+        for (int j = 0; j <= slices; ++j) {
+            double theta = (j == slices) ? 0.0 : 2.0 * M_PI * j / slices;
+            vertices.push_back(static_cast<float>(-sin(theta) * sin(rho)));
+            vertices.push_back(static_cast<float>(cos(theta) * sin(rho)));
+            vertices.push_back(static_cast<float>(cos(rho)));
+            vertices.push_back(static_cast<float>(j) / slices);
+            vertices.push_back(1.0f - static_cast<float>(i) / stacks);
+        }
+    }
+    for (int i = 0; i < stacks; ++i) {
+        for (int j = 0; j < slices; ++j) {
+            GLushort a = static_cast<GLushort>(i * (slices + 1) + j);
+            GLushort b = static_cast<GLushort>(a + slices + 1);
+            indices.push_back(a); indices.push_back(b); indices.push_back(a + 1);
+            indices.push_back(a + 1); indices.push_back(b); indices.push_back(b + 1);
+        }
+    }
+
+    glGenVertexArrays(1, &mesh.vao);
+    glGenBuffers(1, &mesh.vbo);
+    glGenBuffers(1, &mesh.ebo);
+    glBindVertexArray(mesh.vao);
+    glBindBuffer(GL_ARRAY_BUFFER, mesh.vbo);
+    glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(float), vertices.data(), GL_STATIC_DRAW);
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 5 * sizeof(float), nullptr);
+    glEnableVertexAttribArray(1);
+    glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, 5 * sizeof(float), reinterpret_cast<void*>(3 * sizeof(float)));
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, mesh.ebo);
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(GLushort), indices.data(), GL_STATIC_DRAW);
+    mesh.indexCount = static_cast<GLsizei>(indices.size());
+    glBindVertexArray(0);
+}
+
+// Les attributs 2 à 4 pointent sur l'instance first du tampon d'instances
+void CoreRenderer::bindInstanceAttributes(GLuint vao, size_t first, GLuint divisor) {
+    state.bindVertexArray(vao);
+    glBindBuffer(GL_ARRAY_BUFFER, instanceVbo);
+    for (GLuint a = 0; a < 3; ++a) {
+        size_t offset = first * sizeof(Instance) + a * 4 * sizeof(float);
+        glEnableVertexAttribArray(2 + a);
+        glVertexAttribPointer(2 + a, 4, GL_FLOAT, GL_FALSE, sizeof(Instance), reinterpret_cast<void*>(offset));
+        glVertexAttribDivisor(2 + a, divisor);
+    }
+}
+
+void CoreRenderer::render(const std::vector<Planet>& planets, const CameraState& camera, bool occlusion) {
+    GLint viewport[4];
+    glGetIntegerv(GL_VIEWPORT, viewport);
+    double aspect = viewport[3] > 0 ? static_cast<double>(viewport[2]) / viewport[3] : 1.0;
+    const double* eye = camera.eye;
+
+    double projection[16], view[16], rotation[16], viewProjection[16];
+    matrixPerspective(camera.fovy, aspect, camera.zNear, camera.zFar, projection);
+    // Le découpage et le niveau de détail gardent la projection classique (plan lointain fini)
+    double reversed[16];
+    if (depthMode == DEPTH_REVERSE_Z) {
+        matrixPerspectiveReversed(camera.fovy, aspect, camera.zNear, reversed);
+    }
+    matrixLookAt(eye[0], eye[1], eye[2], camera.target[0], camera.target[1], camera.target[2],
+                 camera.up[0], camera.up[1], camera.up[2], view);
+    // Rotation seule pour le GPU : les positions sont déjà relatives à la caméra
+    matrixLookAt(0.0, 0.0, 0.0, camera.target[0] - eye[0], camera.target[1] - eye[1], camera.target[2] - eye[2],
+                 camera.up[0], camera.up[1], camera.up[2], rotation);
+    matrixMultiply(depthMode == DEPTH_REVERSE_Z ? reversed : projection, rotation, viewProjection);
+    RenderView renderView = makeRenderView(eye[0], eye[1], eye[2], projection, view, viewport[3]);
+    OccluderSet occluders;
+    if (occlusion) {
+        occluders.collect(renderView, planets);
+        renderView.occluders = &occluders;
+    }
+
+    CameraBlock block;
+    matrixToFloat(viewProjection, block.viewProjection);
+    block.lightPosition[0] = static_cast<float>(-eye[0]); // Soleil à l'origine
+    block.lightPosition[1] = static_cast<float>(-eye[1]);
+    block.lightPosition[2] = static_cast<float>(-eye[2]);
+    block.lightPosition[3] = 1.0f;
+    block.lightColor[0] = block.lightColor[1] = block.lightColor[2] = 1.0f;
+    block.lightColor[3] = 0.1f; // Lumière ambiante faible
+    block.depthParams[0] = static_cast<float>(1.0 / camera.zNear);
+    block.depthParams[1] = static_cast<float>(1.0 / log2(camera.zFar / camera.zNear + 1.0));
+    block.depthParams[2] = block.depthParams[3] = 0.0f;
+    glBindBuffer(GL_UNIFORM_BUFFER, cameraUbo);
+    glBufferSubData(GL_UNIFORM_BUFFER, 0, sizeof(CameraBlock), &block);
+    glBindBuffer(GL_UNIFORM_BUFFER, 0);
+
+    // Collecter les corps visibles avec leur niveau de détail
+    Arena& arena = frameArena();
+    DrawEntry* entries = arena.allocateArray<DrawEntry>(planets.size());
+    RingEntry* rings = arena.allocateArray<RingEntry>(planets.size());
+    size_t entryCount = 0, ringCount = 0;
+    for (size_t k = 0; k < planets.size(); ++k) {
+        const Planet& planet = planets[k];
+        double cx = planet.x / AU, cy = planet.y / AU, cz = planet.z / AU;
+        double r = planet.radius / AU;
+        double bound = planet.boundingRadius() / AU;
+        bool ringed = planet.rings.present();
+        if (!renderView.frustum.containsSphere(cx, cy, cz, bound)) {
+            profilerAdd(PROFILE_BODIES_CULLED);
+            if (ringed) {
+                profilerAdd(PROFILE_RINGS_CULLED);
+            }
+            continue;
+        }
+        double pixelRadius = projectedRadius(renderView, cx, cy, cz, r);
+
+        // Corps et anneaux testés séparément : l'un peut être dans le champ sans l'autre
+        bool bodyVisible = false;
+        if (!renderView.frustum.containsSphere(cx, cy, cz, r)) {
+            profilerAdd(PROFILE_BODIES_CULLED);
+        } else if (occlusion && occluders.hides(cx, cy, cz, r)) {
+            profilerAdd(PROFILE_BODIES_OCCLUDED);
+        } else {
+            bodyVisible = true;
+            profilerAdd(PROFILE_BODIES_DRAWN);
+        }
+
+        DrawEntry entry;
+        entry.lod = selectLod(pixelRadius);
+        entry.texture = entry.lod == LOD_POINT ? 0 : planet.texture;
+        entry.order = k;
+        Instance& instance = entry.instance;
+        instance.center[0] = static_cast<float>(cx - eye[0]);
+        instance.center[1] = static_cast<float>(cy - eye[1]);
+        instance.center[2] = static_cast<float>(cz - eye[2]);
+        instance.center[3] = static_cast<float>(r);
+        instance.color[0] = planet.r;
+        instance.color[1] = planet.g;
+        instance.color[2] = planet.b;
+        instance.color[3] = static_cast<float>(planet.rotationAngle);
+        instance.params[0] = entry.texture ? 1.0f : 0.0f;
+        instance.params[1] = (cx * cx + cy * cy + cz * cz < r * r) ? 1.0f : 0.0f; // Contient la source de lumière
+        instance.params[2] = static_cast<float>(std::max(1.0, pixelRadius * 2.0));
+        instance.params[3] = 0.0f;
+        if (bodyVisible) {
+            entries[entryCount++] = entry;
+        }
+
+        if (ringed && entry.lod != LOD_POINT) {
+            if (occlusion && occluders.hides(cx, cy, cz, bound)) {
+                profilerAdd(PROFILE_RINGS_CULLED);
+                continue;
+            }
+            // Niveau de détail des anneaux selon leur propre rayon apparent
+            int ringLod = selectLod(projectedRadius(renderView, cx, cy, cz, planet.rings.outerRadius / AU));
+            if (ringLod != LOD_POINT) {
+                profilerAdd(PROFILE_RINGS_DRAWN);
+                RingEntry ringEntry = { { instance.center[0], instance.center[1], instance.center[2] }, &planet.rings, ringLod };
+                rings[ringCount++] = ringEntry;
+            }
+        }
+    }
+
+    // Regrouper par niveau de détail puis par texture : un appel par groupe
+    std::sort(entries, entries + entryCount, drawEntryLess);
+    Instance* instances = arena.allocateArray<Instance>(entryCount);
+    for (size_t k = 0; k < entryCount; ++k) {
+        instances[k] = entries[k].instance;
+    }
+    glBindBuffer(GL_ARRAY_BUFFER, instanceVbo);
+    glBufferData(GL_ARRAY_BUFFER, entryCount * sizeof(Instance), nullptr, GL_STREAM_DRAW); // Renouveler le stockage
+    if (entryCount > 0) {
+        glBufferSubData(GL_ARRAY_BUFFER, 0, entryCount * sizeof(Instance), instances);
+    }
+
+    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+    glActiveTexture(GL_TEXTURE0);
+    state.invalidate();
+
+    size_t first = 0;
+    while (first < entryCount) {
+        size_t last = first + 1;
+        while (last < entryCount && entries[last].lod == entries[first].lod &&
+               entries[last].texture == entries[first].texture) {
+            ++last;
+        }
+        GLsizei count = static_cast<GLsizei>(last - first);
+        if (entries[first].lod == LOD_POINT) {
+            state.useProgram(pointProgram);
+            state.bindVertexArray(pointVao);
+            glDrawArrays(GL_POINTS, static_cast<GLint>(first), count);
+            profilerAdd(PROFILE_DRAW_CALLS);
+        } else {
+            const Mesh& mesh = spheres[entries[first].lod];
+            state.useProgram(sphereProgram);
+            state.bindTexture(entries[first].texture);
+            bindInstanceAttributes(mesh.vao, first, 1);
+            glDrawElementsInstanced(GL_TRIANGLES, mesh.indexCount, GL_UNSIGNED_SHORT, nullptr, count);
+            profilerAdd(PROFILE_DRAW_CALLS);
+        }
+        first = last;
+    }
+
+    // Anneaux translucides après les corps opaques, regroupés par texture
+    if (ringCount > 0) {
+        std::sort(rings, rings + ringCount, ringEntryLess);
+        state.enable(GL_BLEND, true);
+        glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+        state.depthMask(false);
+        state.useProgram(ringProgram);
+        state.bindVertexArray(ringVao);
+        for (size_t k = 0; k < ringCount; ++k) {
+            const RingEntry& ringEntry = rings[k];
+            const RingSystem& system = *ringEntry.rings;
+            glBindBuffer(GL_ARRAY_BUFFER, system.vbo);
+            glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, RING_VERTEX_STRIDE, nullptr);
+            glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, RING_VERTEX_STRIDE, reinterpret_cast<void*>(RING_TEXCOORD_OFFSET));
+            glUniform3fv(ringCenterLocation, 1, ringEntry.center);
+            state.bindTexture(system.texture);
+            glDrawArrays(GL_TRIANGLE_STRIP, system.first[ringEntry.lod], system.count[ringEntry.lod]);
+            profilerAdd(PROFILE_DRAW_CALLS);
+        }
+        state.depthMask(true);
+        state.enable(GL_BLEND, false);
+    }
+
+    // Trajectoires : un seul tampon et un seul appel pour toutes les courbes ; seuls les
+    // morceaux dans le champ sont envoyés
+    TrajectoryRun* runs = arena.allocateArray<TrajectoryRun>(planets.size() * TRAJECTORY_MAX_RUNS);
+    size_t runCount = 0, lineTotal = 0;
+    for (const auto& planet : planets) {
+        const Trajectory& trajectory = planet.trajectory;
+        if (trajectory.size() < 2) {
+            continue;
+        }
+        size_t first[TRAJECTORY_MAX_RUNS], last[TRAJECTORY_MAX_RUNS];
+        size_t visible = trajectory.visibleRuns(renderView.frustum, first, last);
+        for (size_t k = 0; k < visible; ++k) {
+            if (last[k] - first[k] >= 2) {
+                TrajectoryRun run = { &trajectory, first[k], last[k] };
+                runs[runCount++] = run;
+                lineTotal += last[k] - first[k];
+            }
+        }
+    }
+    if (runCount > 0) {
+        float* linePoints = arena.allocateArray<float>(lineTotal * 3);
+        GLint* lineFirst = arena.allocateArray<GLint>(runCount);
+        GLsizei* lineCount = arena.allocateArray<GLsizei>(runCount);
+        size_t point = 0;
+        for (size_t strip = 0; strip < runCount; ++strip) {
+            const TrajectoryRun& run = runs[strip];
+            lineFirst[strip] = static_cast<GLint>(point);
+            lineCount[strip] = static_cast<GLsizei>(run.last - run.first);
+            for (size_t k = run.first; k < run.last; ++k, ++point) {
+                linePoints[3 * point] = static_cast<float>((*run.trajectory)[k].first - eye[0]);
+                linePoints[3 * point + 1] = static_cast<float>((*run.trajectory)[k].second - eye[1]);
+                linePoints[3 * point + 2] = static_cast<float>(-eye[2]);
+            }
+        }
+        state.useProgram(lineProgram);
+        glUniform4f(lineColorLocation, 1.0f, 1.0f, 1.0f, 1.0f);
+        state.bindVertexArray(lineVao);
+        glBindBuffer(GL_ARRAY_BUFFER, lineVbo);
+        glBufferData(GL_ARRAY_BUFFER, lineTotal * 3 * sizeof(float), linePoints, GL_STREAM_DRAW);
+        glMultiDrawArrays(GL_LINE_STRIP, lineFirst, lineCount, static_cast<GLsizei>(runCount));
+        profilerAdd(PROFILE_DRAW_CALLS);
+    }
+
+    state.bindVertexArray(0);
+    state.useProgram(0);
+}
+
+void CoreRenderer::destroy() {
+    GLuint programs[4] = { sphereProgram, pointProgram, ringProgram, lineProgram };
+    for (GLuint program : programs) {
+        if (program) {
+            glDeleteProgram(program);
+        }
+    }
+    sphereProgram = pointProgram = ringProgram = lineProgram = 0;
+
+    for (int l = 0; l < LOD_POINT; ++l) {
+        glDeleteVertexArrays(1, &spheres[l].vao);
+        glDeleteBuffers(1, &spheres[l].vbo);
+        glDeleteBuffers(1, &spheres[l].ebo);
+        spheres[l].vao = spheres[l].vbo = spheres[l].ebo = 0;
+    }
+    glDeleteVertexArrays(1, &ringVao);
+    glDeleteVertexArrays(1, &pointVao);
+    glDeleteVertexArrays(1, &lineVao);
+    glDeleteBuffers(1, &lineVbo);
+    glDeleteBuffers(1, &instanceVbo);
+    glDeleteBuffers(1, &cameraUbo);
+    ringVao = pointVao = lineVao = lineVbo = instanceVbo = cameraUbo = 0;
+}
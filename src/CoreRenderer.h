@@ -0,0 +1,77 @@
+// CoreRenderer.h
+#ifndef CORE_RENDERER_H
+#define CORE_RENDERER_H
+
+#include <cstddef>
+#include <vector>
+#include <GL/glew.h>
+#include "Camera.h"
+#include "Lod.h"
+#include "Options.h"
+#include "Planet.h"
+#include "RenderState.h"
+
+// Rendu OpenGL 3.3 core : shaders, VAO, UBO caméra/lumière et éclairage par pixel.
+// Les corps sans texture d'un même niveau de détail sont dessinés en un seul appel instancié.
+// Toutes les positions envoyées au GPU sont relatives à la caméra, calculées en double.
+// Les tableaux de chaque image sont pris dans frameArena().
+class CoreRenderer {
+public:
+    CoreRenderer();
+
+    // Nécessite un contexte 3.3 core courant ; false si un shader échoue. En DEPTH_REVERSE_Z,
+    // l'appelant encadre render() par DepthTarget::begin/end.
+    bool init(DepthMode mode);
+    // occlusion : ne pas dessiner les corps cachés derrière les grands corps proches
+    void render(const std::vector<Planet>& planets, const CameraState& camera, bool occlusion);
+    void destroy();
+
+private:
+    struct Instance {
+        float center[4]; // xyz relatifs à la caméra, w = rayon (en unités astronomiques)
+        float color[4];  // rgb, a = angle de rotation
+        float params[4]; // x = texturé, y = émissif, z = taille du point en pixels
+    };
+
+    struct DrawEntry {
+        int lod;
+        GLuint texture;
+        size_t order; // Indice du corps, pour un tri déterministe sans tampon de tri stable
+        Instance instance;
+    };
+
+    struct RingEntry {
+        float center[3];
+        const RingSystem* rings;
+        int lod;
+    };
+
+    struct TrajectoryRun {
+        const Trajectory* trajectory;
+        size_t first, last; // Points [first, last) dans l'ordre logique
+    };
+
+    struct Mesh {
+        GLuint vao, vbo, ebo;
+        GLsizei indexCount;
+    };
+
+    static bool drawEntryLess(const DrawEntry& a, const DrawEntry& b);
+    static bool ringEntryLess(const RingEntry& a, const RingEntry& b);
+
+    void createSphereMesh(Mesh& mesh, int slices, int stacks);
+    void bindInstanceAttributes(GLuint vao, size_t first, GLuint divisor);
+
+    DepthMode depthMode;
+    GLuint sphereProgram, pointProgram, ringProgram, lineProgram;
+    GLint lineColorLocation, ringCenterLocation;
+    GLuint cameraUbo;
+    GLuint instanceVbo;
+    Mesh spheres[LOD_POINT];
+    GLuint ringVao; // Format commun, le VBO de chaque système d'anneaux est lié à chaque appel
+    GLuint pointVao;
+    GLuint lineVao, lineVbo;
+    RenderState state;
+};
+
+#endif // CORE_RENDERER_H
@@ -0,0 +1,82 @@
+// DepthTarget.cpp
+#include "DepthTarget.h"
+#include <iostream>
+
+DepthTarget::DepthTarget()
+    : fbo(0), colorBuffer(0), depthBuffer(0), width(0), height(0), previousFramebuffer(0) {
+    for (int k = 0; k < 4; ++k) {
+        viewport[k] = 0;
+    }
+}
+
+bool DepthTarget::supported() {
+    return GLEW_VERSION_4_5 || GLEW_ARB_clip_control; // Les pilotes concernés ont tous les FBO
+}
+
+bool DepthTarget::allocate(int w, int h) {
+    if (!fbo) {
+        glGenFramebuffers(1, &fbo);
+        glGenRenderbuffers(1, &colorBuffer);
+        glGenRenderbuffers(1, &depthBuffer);
+    }
+    glBindRenderbuffer(GL_RENDERBUFFER, colorBuffer);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_RGBA8, w, h);
+    glBindRenderbuffer(GL_RENDERBUFFER, depthBuffer);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT32F, w, h);
+    glBindRenderbuffer(GL_RENDERBUFFER, 0);
+    glBindFramebuffer(GL_FRAMEBUFFER, fbo);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, colorBuffer);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_RENDERBUFFER, depthBuffer);
+    GLenum status = glCheckFramebufferStatus(GL_FRAMEBUFFER);
+    if (status != GL_FRAMEBUFFER_COMPLETE) {
+        std::cerr << "Failed to create depth framebuffer (status 0x" << std::hex << status << std::dec << ")" << std::endl;
+        return false;
+    }
+    width = w;
+    height = h;
+    return true;
+}
+
+void DepthTarget::begin() {
+    glGetIntegerv(GL_DRAW_FRAMEBUFFER_BINDING, &previousFramebuffer);
+    glGetIntegerv(GL_VIEWPORT, viewport);
+    bool ready = width > 0 && viewport[2] == width && viewport[3] == height;
+    if (!ready && viewport[2] > 0 && viewport[3] > 0) {
+        ready = allocate(viewport[2], viewport[3]);
+    }
+    if (ready) {
+        glBindFramebuffer(GL_FRAMEBUFFER, fbo);
+        glViewport(0, 0, width, height);
+    } else {
+        width = height = 0; // Image rendue sans FBO (fenêtre réduite, ou nouvel essai à la suivante)
+        glBindFramebuffer(GL_FRAMEBUFFER, previousFramebuffer);
+    }
+    glClipControl(GL_LOWER_LEFT, GL_ZERO_TO_ONE);
+    glClearDepth(0.0);
+    glDepthFunc(GL_GREATER);
+}
+
+void DepthTarget::end() {
+    glClipControl(GL_LOWER_LEFT, GL_NEGATIVE_ONE_TO_ONE);
+    glClearDepth(1.0);
+    glDepthFunc(GL_LESS);
+    if (width == 0) {
+        return;
+    }
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, fbo);
+    glBindFramebuffer(GL_DRAW_FRAMEBUFFER, previousFramebuffer);
+    glBlitFramebuffer(0, 0, width, height, viewport[0], viewport[1], viewport[0] + width, viewport[1] + height,
+                      GL_COLOR_BUFFER_BIT, GL_NEAREST);
+    glBindFramebuffer(GL_FRAMEBUFFER, previousFramebuffer);
+    glViewport(viewport[0], viewport[1], viewport[2], viewport[3]);
+}
+
+void DepthTarget::destroy() {
+    if (fbo) {
+        glDeleteFramebuffers(1, &fbo);
+        glDeleteRenderbuffers(1, &colorBuffer);
+        glDeleteRenderbuffers(1, &depthBuffer);
+    }
+    fbo = colorBuffer = depthBuffer = 0;
+    width = height = 0;
+}
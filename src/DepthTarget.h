@@ -0,0 +1,35 @@
+// DepthTarget.h
+#ifndef DEPTH_TARGET_H
+#define DEPTH_TARGET_H
+
+#include <GL/glew.h>
+
+// Profondeur inversée (reverse-Z) : la projection envoie le plan proche à 1 et l'infini à 0,
+// glClipControl garde cet intervalle [0, 1] tel quel et le test devient GL_GREATER. Avec un
+// tampon flottant, la précision relative est alors presque constante sur toute la distance
+// (l'exposant du flottant compense la décroissance en 1/z). Le tampon de profondeur de la
+// fenêtre étant en virgule fixe, l'image est rendue dans un FBO à profondeur 32 bits
+// flottants, puis sa couleur est recopiée dans le framebuffer qui était lié.
+class DepthTarget {
+public:
+    DepthTarget();
+
+    static bool supported(); // glClipControl (OpenGL 4.5 ou ARB_clip_control)
+
+    // Lie le FBO à la taille du viewport courant (recréé si elle change) et règle l'état de la
+    // profondeur inversée ; le rendu efface et dessine ensuite comme d'habitude
+    void begin();
+    // Recopie la couleur dans le framebuffer lié avant begin et rétablit l'état par défaut
+    void end();
+    void destroy();
+
+private:
+    bool allocate(int width, int height);
+
+    GLuint fbo, colorBuffer, depthBuffer;
+    int width, height;
+    GLint viewport[4];
+    GLint previousFramebuffer;
+};
+
+#endif // DEPTH_TARGET_H
@@ -0,0 +1,69 @@
+// Diagnostics.cpp
+#include "Diagnostics.h"
+#include <cmath>
+#include <iostream>
+
+void measureConservation(const std::vector<Planet>& planets, ConservationSample& sample) {
+    sample.kinetic = 0.0;
+    sample.momentumScale = sample.angularScale = 0.0;
+    for (int c = 0; c < 3; ++c) {
+        sample.momentum[c] = sample.angularMomentum[c] = 0.0;
+    }
+    for (const auto& p : planets) {
+        double v2 = p.vx * p.vx + p.vy * p.vy + p.vz * p.vz;
+        double lx = p.mass * (p.y * p.vz - p.z * p.vy);
+        double ly = p.mass * (p.z * p.vx - p.x * p.vz);
+        double lz = p.mass * (p.x * p.vy - p.y * p.vx);
+        sample.kinetic += 0.5 * p.mass * v2;
+        sample.momentum[0] += p.mass * p.vx;
+        sample.momentum[1] += p.mass * p.vy;
+        sample.momentum[2] += p.mass * p.vz;
+        sample.angularMomentum[0] += lx;
+        sample.angularMomentum[1] += ly;
+        sample.angularMomentum[2] += lz;
+        sample.momentumScale += p.mass * sqrt(v2);
+        sample.angularScale += sqrt(lx * lx + ly * ly + lz * lz);
+    }
+}
+
+static double distance3(const double* a, const double* b) {
+    double dx = a[0] - b[0], dy = a[1] - b[1], dz = a[2] - b[2];
+    return sqrt(dx * dx + dy * dy + dz * dz);
+}
+
+ConservationMonitor::ConservationMonitor(double energyThreshold, double momentumThreshold) : hasReference(false) {
+    thresholds[ENERGY] = energyThreshold;
+    thresholds[MOMENTUM] = thresholds[ANGULAR_MOMENTUM] = momentumThreshold;
+    for (int q = 0; q < QUANTITY_COUNT; ++q) {
+        nextAlert[q] = thresholds[q];
+    }
+}
+
+void ConservationMonitor::check(Quantity quantity, long long step, double drift) {
+    static const char* names[QUANTITY_COUNT] = { "energy", "momentum", "angular momentum" };
+    if (!(drift <= nextAlert[quantity])) { // NaN compris
+        std::cerr << "Warning: relative " << names[quantity] << " drift " << drift << " exceeds "
+                  << thresholds[quantity] << " at step " << step << " (time step too large?)" << std::endl;
+        nextAlert[quantity] = std::isnan(drift) ? INFINITY : 10.0 * drift;
+    }
+}
+
+void ConservationMonitor::report(long long step, const ConservationSample& sample, std::ostream& out) {
+    if (!hasReference) {
+        reference = sample;
+        hasReference = true;
+    }
+    double energy = sample.kinetic + sample.potential;
+    double initialEnergy = reference.kinetic + reference.potential;
+    double energyDrift = initialEnergy != 0.0 ? fabs((energy - initialEnergy) / initialEnergy) : 0.0;
+    double momentumDrift = reference.momentumScale > 0.0
+        ? distance3(sample.momentum, reference.momentum) / reference.momentumScale : 0.0;
+    double angularDrift = reference.angularScale > 0.0
+        ? distance3(sample.angularMomentum, reference.angularMomentum) / reference.angularScale : 0.0;
+
+    out << "Conservation [step " << step << "]: energy " << energy << " J (drift " << energyDrift << "), momentum drift "
+        << momentumDrift << ", angular momentum drift " << angularDrift << std::endl;
+    check(ENERGY, step, energyDrift);
+    check(MOMENTUM, step, momentumDrift);
+    check(ANGULAR_MOMENTUM, step, angularDrift);
+}
@@ -0,0 +1,45 @@
+// Diagnostics.h
+#ifndef DIAGNOSTICS_H
+#define DIAGNOSTICS_H
+
+#include <ostream>
+#include <vector>
+#include "Planet.h"
+
+// Grandeurs conservées mesurées au début d'un pas : l'énergie potentielle vient de la passe de
+// forces du même pas (addForceTasks), le reste d'une boucle sur les corps qui tourne en parallèle
+// de cette passe, les deux lisant les mêmes positions.
+struct ConservationSample {
+    double kinetic;            // Énergie cinétique (en joules)
+    double potential;          // Énergie potentielle, adoucie comme les forces (en joules)
+    double momentum[3];        // Quantité de mouvement totale (kg m/s)
+    double angularMomentum[3]; // Moment cinétique par rapport à l'origine (kg m²/s)
+    double momentumScale;      // Somme des m |v|, échelle des écarts de quantité de mouvement
+    double angularScale;       // Somme des m |r x v|, échelle des écarts de moment cinétique
+};
+
+// Énergie cinétique, quantité de mouvement et moment cinétique ; potential n'est pas touché
+void measureConservation(const std::vector<Planet>& planets, ConservationSample& sample);
+
+// Écarts relatifs à la première mesure, journalisés avec les empreintes d'état (sortie standard) ;
+// un écart qui dépasse son seuil produit une alerte sur la sortie d'erreur, répétée seulement
+// quand il a décuplé depuis la précédente.
+class ConservationMonitor {
+public:
+    ConservationMonitor(double energyThreshold, double momentumThreshold);
+
+    // step : pas déjà effectués au moment de la mesure
+    void report(long long step, const ConservationSample& sample, std::ostream& out);
+
+private:
+    enum Quantity { ENERGY, MOMENTUM, ANGULAR_MOMENTUM, QUANTITY_COUNT };
+
+    void check(Quantity quantity, long long step, double drift);
+
+    bool hasReference;
+    ConservationSample reference;
+    double thresholds[QUANTITY_COUNT];
+    double nextAlert[QUANTITY_COUNT];
+};
+
+#endif // DIAGNOSTICS_H
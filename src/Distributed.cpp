@@ -0,0 +1,530 @@
+// Distributed.cpp
+#include "Distributed.h"
+#include "Arena.h"
+#include "BarnesHut.h"
+#include "Parallel.h"
+#include "Physics.h"
+#include "Scheduler.h"
+#include "SolarSystem.h"
+#include "SpatialOrder.h"
+#include "Transport.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <csignal>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <sys/wait.h>
+#include <unistd.h>
+
+static const size_t DOMAIN_SAMPLES = 1024; // Échantillons de clés envoyés par chaque processus
+
+struct DistributedBody {
+    double x, y, z, vx, vy, vz, mass;
+    double softening; // Longueur d'adoucissement (en mètres)
+    double cost;     // Interactions calculées au pas précédent : poids pour l'équilibrage
+    unsigned int id; // Indice de création, comme Planet::id
+};
+
+// Source importée d'un autre domaine : un corps, ou le centre de masse d'un nœud lointain
+struct LetSource {
+    double x, y, z, mass, softening;
+};
+
+struct WeightedKey {
+    uint64_t key;
+    double weight;
+};
+
+static bool weightedKeyLess(const WeightedKey& a, const WeightedKey& b) {
+    if (a.key != b.key) return a.key < b.key;
+    return a.weight < b.weight;
+}
+
+// Découpage de l'espace, identique dans tous les processus : domaine r = clés de Morton
+// dans [splitters[r - 1], splitters[r])
+struct Domain {
+    double lo[3];
+    double scale[3];
+    std::vector<uint64_t> splitters;
+};
+
+struct Box {
+    double lo[3], hi[3];
+};
+
+struct RankStatistics {
+    double bodies;       // Corps possédés au dernier pas
+    double imported;     // Sources reçues des autres domaines au dernier pas
+    double interactions; // Termes de force calculés au dernier pas
+    double bytesSent;
+    double computeTime;  // Arbres, forces et intégration (secondes)
+    double exchangeTime; // Décomposition, migration et échange des LET, attente comprise
+};
+
+template <typename T>
+static void packValues(const T* values, size_t count, std::vector<char>& out) {
+    out.resize(count * sizeof(T));
+    if (count > 0) {
+        memcpy(out.data(), values, out.size());
+    }
+}
+
+template <typename T>
+static void appendValues(const std::vector<char>& in, std::vector<T>& values) {
+    size_t count = in.size() / sizeof(T);
+    size_t first = values.size();
+    values.resize(first + count);
+    if (count > 0) {
+        memcpy(&values[first], in.data(), count * sizeof(T));
+    }
+}
+
+static Box boundingBox(const std::vector<DistributedBody>& bodies) {
+    Box box;
+    for (int c = 0; c < 3; ++c) {
+        box.lo[c] = std::numeric_limits<double>::infinity();
+        box.hi[c] = -std::numeric_limits<double>::infinity();
+    }
+    for (const auto& b : bodies) {
+        const double position[3] = { b.x, b.y, b.z };
+        for (int c = 0; c < 3; ++c) {
+            box.lo[c] = std::min(box.lo[c], position[c]);
+            box.hi[c] = std::max(box.hi[c], position[c]);
+        }
+    }
+    return box;
+}
+
+static bool boxEmpty(const Box& box) {
+    return box.lo[0] > box.hi[0];
+}
+
+static uint64_t bodyKey(const DistributedBody& b, const Domain& domain) {
+    return mortonKey(b.x, b.y, b.z, domain.lo, domain.scale);
+}
+
+static int ownerOf(uint64_t key, const Domain& domain) {
+    return static_cast<int>(std::upper_bound(domain.splitters.begin(), domain.splitters.end(), key) -
+                            domain.splitters.begin());
+}
+
+// Nouvelle boîte commune (avec une marge, les corps bougent jusqu'au prochain équilibrage ; au-delà
+// leur clé est ramenée au bord) et nouvelles bornes, à poids égaux. Opération collective.
+static bool computeDomain(Transport& transport, const std::vector<DistributedBody>& bodies, Domain& domain) {
+    Box local = boundingBox(bodies);
+    std::vector<char> packed;
+    std::vector<std::vector<char>> gathered;
+    packValues(&local, 1, packed);
+    if (!transport.allGather(packed, gathered)) {
+        return false;
+    }
+    Box global = local;
+    for (const auto& part : gathered) {
+        Box box;
+        memcpy(&box, part.data(), sizeof(Box));
+        for (int c = 0; c < 3; ++c) {
+            global.lo[c] = std::min(global.lo[c], box.lo[c]);
+            global.hi[c] = std::max(global.hi[c], box.hi[c]);
+        }
+    }
+    double extent = 0.0;
+    for (int c = 0; c < 3; ++c) {
+        extent = std::max(extent, global.hi[c] - global.lo[c]);
+    }
+    extent = extent > 0.0 ? extent * 1.1 : 1.0;
+    for (int c = 0; c < 3; ++c) {
+        domain.lo[c] = 0.5 * (global.lo[c] + global.hi[c]) - 0.5 * extent;
+        domain.scale[c] = MORTON_CELLS / extent;
+    }
+
+    // Échantillons aux quantiles de poids local : chacun représente la même part du poids local
+    std::vector<WeightedKey> keys(bodies.size());
+    double localWeight = 0.0;
+    for (size_t k = 0; k < bodies.size(); ++k) {
+        keys[k].key = bodyKey(bodies[k], domain);
+        keys[k].weight = bodies[k].cost;
+        localWeight += bodies[k].cost;
+    }
+    std::sort(keys.begin(), keys.end(), weightedKeyLess);
+    std::vector<WeightedKey> samples;
+    if (!keys.empty()) {
+        size_t count = std::min(DOMAIN_SAMPLES, keys.size());
+        double cumulative = 0.0;
+        size_t k = 0;
+        for (size_t s = 0; s < count; ++s) {
+            double target = (s + 0.5) * localWeight / count;
+            while (k + 1 < keys.size() && cumulative + keys[k].weight < target) {
+                cumulative += keys[k].weight;
+                ++k;
+            }
+            WeightedKey sample = { keys[k].key, localWeight / count };
+            samples.push_back(sample);
+        }
+    }
+    packValues(samples.data(), samples.size(), packed);
+    if (!transport.allGather(packed, gathered)) {
+        return false;
+    }
+    std::vector<WeightedKey> all;
+    for (const auto& part : gathered) {
+        appendValues(part, all);
+    }
+    std::sort(all.begin(), all.end(), weightedKeyLess);
+    double total = 0.0;
+    for (const auto& sample : all) {
+        total += sample.weight;
+    }
+
+    int ranks = transport.size();
+    domain.splitters.assign(ranks - 1, std::numeric_limits<uint64_t>::max());
+    double cumulative = 0.0;
+    int next = 1;
+    for (size_t s = 0; s < all.size() && next < ranks; ++s) {
+        cumulative += all[s].weight;
+        while (next < ranks && cumulative >= total * next / ranks) {
+            domain.splitters[next - 1] = all[s].key + 1;
+            ++next;
+        }
+    }
+    return true;
+}
+
+// Envoie chaque corps au processus de son domaine. Opération collective.
+static bool migrateBodies(Transport& transport, std::vector<DistributedBody>& bodies, const Domain& domain) {
+    int ranks = transport.size();
+    std::vector<std::vector<DistributedBody>> outgoing(ranks);
+    for (const auto& b : bodies) {
+        outgoing[ownerOf(bodyKey(b, domain), domain)].push_back(b);
+    }
+    std::vector<std::vector<char>> out(ranks), in;
+    for (int r = 0; r < ranks; ++r) {
+        packValues(outgoing[r].data(), outgoing[r].size(), out[r]);
+    }
+    if (!transport.allToAll(out, in)) {
+        return false;
+    }
+    bodies.clear();
+    for (int r = 0; r < ranks; ++r) {
+        appendValues(in[r], bodies);
+    }
+    return true;
+}
+
+// Partie de l'arbre local utile au domaine de boîte box : un nœud dont la taille est inférieure
+// à theta fois la distance à la boîte serait accepté par tout corps du domaine, son centre de
+// masse suffit ; sinon on descend, jusqu'aux corps des feuilles
+static void exportLet(const BarnesHutTree& tree, const Box& box, double theta, std::vector<LetSource>& out) {
+    out.clear();
+    if (tree.nodeCount == 0 || boxEmpty(box)) {
+        return;
+    }
+    const double theta2 = theta * theta;
+    std::vector<unsigned int> stack(1, 0);
+    while (!stack.empty()) {
+        const BarnesHutNode& node = tree.nodes[stack.back()];
+        stack.pop_back();
+        double d2 = 0.0;
+        for (int c = 0; c < 3; ++c) {
+            double gap = std::max(0.0, std::max(node.lo[c] - box.hi[c], box.lo[c] - node.hi[c]));
+            d2 += gap * gap;
+        }
+        if (node.size2 < theta2 * d2) {
+            LetSource source = { node.com[0], node.com[1], node.com[2], node.mass, node.softening };
+            out.push_back(source);
+        } else if (node.childCount == 0) {
+            for (unsigned int j = node.begin; j < node.end; ++j) {
+                LetSource source = { tree.x[j], tree.y[j], tree.z[j], tree.mass[j], tree.softening[j] };
+                out.push_back(source);
+            }
+        } else {
+            for (unsigned int c = 0; c < node.childCount; ++c) {
+                stack.push_back(node.firstChild + c);
+            }
+        }
+    }
+}
+
+static double secondsSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+// Un pas : décomposition (si rebalance), migration, LET, forces et intégration des corps locaux
+static bool stepRank(Transport& transport, std::vector<DistributedBody>& bodies, Domain& domain, bool rebalance,
+                     const SimulationOptions& options, RankStatistics& statistics) {
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    if (rebalance && !computeDomain(transport, bodies, domain)) {
+        return false;
+    }
+    if (!migrateBodies(transport, bodies, domain)) {
+        return false;
+    }
+    Box local = boundingBox(bodies);
+    std::vector<char> packed;
+    std::vector<std::vector<char>> gathered;
+    packValues(&local, 1, packed);
+    if (!transport.allGather(packed, gathered)) {
+        return false;
+    }
+    statistics.exchangeTime += secondsSince(start);
+
+    start = std::chrono::steady_clock::now();
+    Arena& arena = stepArena();
+    size_t n = bodies.size();
+    double* x = arena.allocateArray<double>(n);
+    double* y = arena.allocateArray<double>(n);
+    double* z = arena.allocateArray<double>(n);
+    double* mass = arena.allocateArray<double>(n);
+    double* softening = arena.allocateArray<double>(n);
+    for (size_t k = 0; k < n; ++k) {
+        x[k] = bodies[k].x;
+        y[k] = bodies[k].y;
+        z[k] = bodies[k].z;
+        mass[k] = bodies[k].mass;
+        softening[k] = bodies[k].softening;
+    }
+    BarnesHutTree localTree;
+    buildBarnesHutTree(x, y, z, mass, softening, n, localTree);
+
+    int ranks = transport.size();
+    std::vector<std::vector<char>> out(ranks), in;
+    std::vector<LetSource> sources;
+    for (int r = 0; r < ranks; ++r) {
+        if (r != transport.rank()) {
+            Box box;
+            memcpy(&box, gathered[r].data(), sizeof(Box));
+            exportLet(localTree, box, options.theta, sources);
+            packValues(sources.data(), sources.size(), out[r]);
+        }
+    }
+    double computeTime = secondsSince(start);
+
+    start = std::chrono::steady_clock::now();
+    if (!transport.allToAll(out, in)) {
+        return false;
+    }
+    statistics.exchangeTime += secondsSince(start);
+
+    start = std::chrono::steady_clock::now();
+    sources.clear();
+    for (int r = 0; r < ranks; ++r) {
+        if (r != transport.rank()) {
+            appendValues(in[r], sources);
+        }
+    }
+
+    // Sources importées après les corps locaux : seuls les n premiers reçoivent une force
+    const BarnesHutTree* tree = &localTree;
+    BarnesHutTree combinedTree;
+    size_t total = n + sources.size();
+    if (!sources.empty()) {
+        double* cx = arena.allocateArray<double>(total);
+        double* cy = arena.allocateArray<double>(total);
+        double* cz = arena.allocateArray<double>(total);
+        double* cmass = arena.allocateArray<double>(total);
+        double* csoftening = arena.allocateArray<double>(total);
+        std::copy(x, x + n, cx);
+        std::copy(y, y + n, cy);
+        std::copy(z, z + n, cz);
+        std::copy(mass, mass + n, cmass);
+        std::copy(softening, softening + n, csoftening);
+        for (size_t k = 0; k < sources.size(); ++k) {
+            cx[n + k] = sources[k].x;
+            cy[n + k] = sources[k].y;
+            cz[n + k] = sources[k].z;
+            cmass[n + k] = sources[k].mass;
+            csoftening[n + k] = sources[k].softening;
+        }
+        buildBarnesHutTree(cx, cy, cz, cmass, csoftening, total, combinedTree);
+        tree = &combinedTree;
+    }
+
+    double* ax = arena.allocateZeroed<double>(n);
+    double* ay = arena.allocateZeroed<double>(n);
+    double* az = arena.allocateZeroed<double>(n);
+    unsigned int* interactions = arena.allocateZeroed<unsigned int>(n);
+    TaskGraph graph;
+    for (size_t begin = 0; begin < total; begin += BARNES_HUT_TILE) {
+        size_t end = std::min(total, begin + BARNES_HUT_TILE);
+        graph.add([=] { barnesHutAccelerations(*tree, begin, end, options.theta, n, ax, ay, az, interactions); });
+    }
+    graph.run(resolveThreadCount(options.threads));
+
+    // Mêmes opérations que Planet::update
+    double interactionCount = 0.0;
+    const double dt = options.dt;
+    for (size_t k = 0; k < n; ++k) {
+        DistributedBody& b = bodies[k];
+        b.vx += ax[k] * dt;
+        b.vy += ay[k] * dt;
+        b.vz += az[k] * dt;
+        b.x += b.vx * dt;
+        b.y += b.vy * dt;
+        b.z += b.vz * dt;
+        b.cost = interactions[k] + 1.0;
+        interactionCount += interactions[k];
+    }
+    resetStepArena();
+    statistics.computeTime += computeTime + secondsSince(start);
+
+    statistics.bodies = static_cast<double>(n);
+    statistics.imported = static_cast<double>(sources.size());
+    statistics.interactions = interactionCount;
+    statistics.bytesSent = static_cast<double>(transport.bytesSent());
+    return true;
+}
+
+// Rassemble tous les corps sur le processus 0 (vide ailleurs), dans l'ordre des identifiants
+static bool gatherBodies(Transport& transport, const std::vector<DistributedBody>& bodies,
+                         std::vector<DistributedBody>& all) {
+    std::vector<char> packed, none;
+    all.clear();
+    if (transport.rank() != 0) {
+        packValues(bodies.data(), bodies.size(), packed);
+        return transport.exchange(0, packed, -1, none);
+    }
+    all = bodies;
+    for (int r = 1; r < transport.size(); ++r) {
+        if (!transport.exchange(-1, none, r, packed)) {
+            return false;
+        }
+        appendValues(packed, all);
+    }
+    std::sort(all.begin(), all.end(), [](const DistributedBody& a, const DistributedBody& b) { return a.id < b.id; });
+    return true;
+}
+
+static bool logStateHash(Transport& transport, const std::vector<DistributedBody>& bodies, long long step) {
+    std::vector<DistributedBody> all;
+    if (!gatherBodies(transport, bodies, all)) {
+        return false;
+    }
+    if (transport.rank() == 0) {
+        uint64_t hash = STATE_HASH_BASIS; // Même définition que stateHash
+        for (const auto& b : all) {
+            const double values[7] = { b.x, b.y, b.z, b.vx, b.vy, b.vz, b.mass };
+            hashDoubles(hash, values, 7);
+        }
+        std::cout << "State hash [step " << step << "]: " << std::hex << std::setw(16) << std::setfill('0') << hash
+                  << std::dec << std::setfill(' ') << std::endl;
+    }
+    return true;
+}
+
+// Corps initiaux, tous créés par le processus 0 : la première migration les répartit
+static void createBodies(const SimulationOptions& options, std::vector<DistributedBody>& bodies) {
+    std::vector<BodyState> states = solarSystemInitialState();
+    std::vector<Planet> debris;
+    addDebrisDisk(debris, options.debrisCount, options.seed); // Sans texture : pas de contexte OpenGL
+    for (size_t k = 0; k < states.size(); ++k) {
+        const BodyState& s = states[k];
+        double softening = bodySoftening(s.radius, options.softeningLength, options.softeningRadius);
+        DistributedBody b = { s.x, s.y, s.z, s.vx, s.vy, s.vz, s.mass, softening, 1.0, static_cast<unsigned int>(k) };
+        bodies.push_back(b);
+    }
+    for (const auto& p : debris) {
+        double softening = bodySoftening(p.radius, options.softeningLength, options.softeningRadius);
+        DistributedBody b = { p.x, p.y, p.z, p.vx, p.vy, p.vz, p.mass, softening, 1.0,
+                              static_cast<unsigned int>(states.size() + p.id) };
+        bodies.push_back(b);
+    }
+}
+
+static int runRank(Transport& transport, const SimulationOptions& options) {
+    std::vector<DistributedBody> bodies;
+    if (transport.rank() == 0) {
+        createBodies(options, bodies);
+    }
+    size_t bodyCount = bodies.size();
+
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    Domain domain;
+    RankStatistics statistics = {};
+    for (long long step = 1; step <= options.distributedSteps; ++step) {
+        bool rebalance = step == 1 || (options.rebalanceInterval > 0 && (step - 1) % options.rebalanceInterval == 0);
+        if (!stepRank(transport, bodies, domain, rebalance, options, statistics)) {
+            return -1;
+        }
+        if (options.hashInterval > 0 && step % options.hashInterval == 0 && !logStateHash(transport, bodies, step)) {
+            return -1;
+        }
+    }
+    double elapsed = secondsSince(start);
+    if (options.hashInterval <= 0 && !logStateHash(transport, bodies, options.distributedSteps)) {
+        return -1;
+    }
+
+    // Bilan par processus, affiché par le processus 0
+    std::vector<char> packed;
+    std::vector<std::vector<char>> gathered;
+    packValues(&statistics, 1, packed);
+    if (!transport.allGather(packed, gathered)) {
+        return -1;
+    }
+    if (transport.rank() != 0) {
+        return 0;
+    }
+    std::cout << "Distributed run: " << bodyCount << " bodies, " << transport.size() << " process(es) over "
+              << (options.transport == TRANSPORT_SOCKET ? "sockets" : "shared memory") << ", "
+              << options.distributedSteps << " steps in " << elapsed << " s" << std::endl;
+    double maxInteractions = 0.0, sumInteractions = 0.0;
+    for (int r = 0; r < transport.size(); ++r) {
+        RankStatistics s;
+        memcpy(&s, gathered[r].data(), sizeof(RankStatistics));
+        std::cout << "  rank " << r << ": " << s.bodies << " bodies, " << s.imported << " imported sources, "
+                  << s.interactions << " interactions, " << s.bytesSent / (1024.0 * 1024.0) << " MB sent, compute "
+                  << s.computeTime << " s, exchange " << s.exchangeTime << " s" << std::endl;
+        maxInteractions = std::max(maxInteractions, s.interactions);
+        sumInteractions += s.interactions;
+    }
+    if (sumInteractions > 0.0) {
+        std::cout << "  load imbalance (max / mean interactions): "
+                  << maxInteractions * transport.size() / sumInteractions << std::endl;
+    }
+    return 0;
+}
+
+int runDistributed(const SimulationOptions& options) {
+    int ranks = options.distributedRanks;
+    Transport transport;
+    if (!transport.create(options.transport, ranks)) {
+        return -1;
+    }
+
+    // Aucun thread n'existe encore : fork() est sûr. Vider les tampons pour ne rien dupliquer.
+    std::cout.flush();
+    std::cerr.flush();
+    std::vector<pid_t> children;
+    for (int r = 1; r < ranks; ++r) {
+        pid_t pid = fork();
+        if (pid < 0) {
+            std::cerr << "Failed to start process for rank " << r << std::endl;
+            for (pid_t child : children) {
+                kill(child, SIGTERM);
+                waitpid(child, nullptr, 0);
+            }
+            return -1;
+        }
+        if (pid == 0) {
+            transport.attach(r);
+            int result = runRank(transport, options);
+            std::cout.flush();
+            _exit(result == 0 ? 0 : 1);
+        }
+        children.push_back(pid);
+    }
+
+    transport.attach(0);
+    int result = runRank(transport, options);
+    transport.destroy(); // Débloque les pairs en attente si ce processus a échoué
+    for (size_t k = 0; k < children.size(); ++k) {
+        int status = 0;
+        if (waitpid(children[k], &status, 0) < 0 || !WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+            std::cerr << "Rank " << k + 1 << " failed" << std::endl;
+            result = -1;
+        }
+    }
+    return result;
+}
@@ -0,0 +1,22 @@
+// Distributed.h
+#ifndef DISTRIBUTED_H
+#define DISTRIBUTED_H
+
+#include "Options.h"
+
+// Mode --distributed P : le système solaire et ses --debris répartis entre P processus de la
+// même machine, reliés par un Transport (sockets ou mémoire partagée). À chaque pas :
+//  - décomposition : chaque processus possède un intervalle de la courbe de Morton dans une
+//    boîte commune ; les bornes sont recalculées tous les --rebalance-interval pas à partir
+//    d'échantillons pondérés par le coût (interactions) de chaque corps au pas précédent,
+//    pour que chaque processus ait la même charge et non le même nombre de corps ;
+//  - migration des corps sortis de leur domaine ;
+//  - arbre essentiel local (LET) : chaque processus parcourt son octree de Barnes-Hut avec la
+//    boîte de chaque autre domaine et lui envoie les nœuds assez lointains pour tout ce domaine
+//    (centre de masse seul) et les corps des feuilles trop proches ;
+//  - forces de Barnes-Hut sur l'arbre des corps locaux et des sources importées, puis intégration.
+// Avec un seul processus, le résultat est celui de --forces barnes-hut bit à bit ; avec plusieurs,
+// il s'en écarte de l'ordre de l'erreur du critère d'ouverture.
+int runDistributed(const SimulationOptions& options);
+
+#endif // DISTRIBUTED_H
@@ -0,0 +1,249 @@
+// Ensemble.cpp
+#include "Ensemble.h"
+#include "Parallel.h"
+#include "Physics.h"
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <random>
+
+// Lot de ENSEMBLE_LANES systèmes en structure de tableaux : valeur[corps * LANES + voie]
+struct EnsembleBatch {
+    size_t bodies;
+    std::vector<double> x, y, z, vx, vy, vz, ax, ay, az, mass;
+    std::vector<double> softening; // Une valeur par corps, commune à toutes les voies
+    double minSeparation[ENSEMBLE_LANES];
+
+    EnsembleBatch(size_t _bodies, const std::vector<double>& _softening)
+        : bodies(_bodies), x(_bodies * ENSEMBLE_LANES), y(x.size()), z(x.size()), vx(x.size()), vy(x.size()),
+          vz(x.size()), ax(x.size(), 0.0), ay(x.size(), 0.0), az(x.size(), 0.0), mass(x.size()), softening(_softening) {
+        for (int l = 0; l < ENSEMBLE_LANES; ++l) {
+            minSeparation[l] = std::numeric_limits<double>::infinity();
+        }
+    }
+};
+
+// Mêmes opérations, dans le même ordre, que computeGravitationalForce et Planet::update
+static void stepBatch(EnsembleBatch& batch, double dt, SofteningKernel kernel) {
+    const int L = ENSEMBLE_LANES;
+    const size_t n = batch.bodies;
+    const double* __restrict x = batch.x.data();
+    const double* __restrict y = batch.y.data();
+    const double* __restrict z = batch.z.data();
+    const double* __restrict m = batch.mass.data();
+    double* __restrict ax = batch.ax.data();
+    double* __restrict ay = batch.ay.data();
+    double* __restrict az = batch.az.data();
+    double* __restrict minSeparation = batch.minSeparation;
+
+    for (size_t i = 0; i < n; ++i) {
+        for (size_t j = i + 1; j < n; ++j) {
+            const size_t oi = i * L, oj = j * L;
+            const double epsilon = pairSoftening(batch.softening[i], batch.softening[j]);
+            // Le noyau est choisi hors de la boucle des voies, qui reste vectorisable
+            if (kernel == SOFTENING_CLAMP) {
+                for (int l = 0; l < L; ++l) {
+                    double dx = x[oj + l] - x[oi + l];
+                    double dy = y[oj + l] - y[oi + l];
+                    double dz = z[oj + l] - z[oi + l];
+                    double dist = sqrt(dx*dx + dy*dy + dz*dz);
+                    minSeparation[l] = dist < minSeparation[l] ? dist : minSeparation[l];
+                    dist = dist < epsilon ? epsilon : dist; // Distance minimale, comme dans computeGravitationalForce
+                    double force = G * m[oi + l] * m[oj + l] / (dist * dist);
+                    double fx = force * dx / dist;
+                    double fy = force * dy / dist;
+                    double fz = force * dz / dist;
+                    ax[oi + l] += fx / m[oi + l];
+                    ay[oi + l] += fy / m[oi + l];
+                    az[oi + l] += fz / m[oi + l];
+                    ax[oj + l] -= fx / m[oj + l];
+                    ay[oj + l] -= fy / m[oj + l];
+                    az[oj + l] -= fz / m[oj + l];
+                }
+                continue;
+            }
+            for (int l = 0; l < L; ++l) {
+                double dx = x[oj + l] - x[oi + l];
+                double dy = y[oj + l] - y[oi + l];
+                double dz = z[oj + l] - z[oi + l];
+                double r2 = dx*dx + dy*dy + dz*dz;
+                double dist = sqrt(r2);
+                minSeparation[l] = dist < minSeparation[l] ? dist : minSeparation[l];
+                double factor = G * softenedForceFactor(kernel, r2, epsilon);
+                ax[oi + l] += factor * m[oj + l] * dx;
+                ay[oi + l] += factor * m[oj + l] * dy;
+                az[oi + l] += factor * m[oj + l] * dz;
+                ax[oj + l] -= factor * m[oi + l] * dx;
+                ay[oj + l] -= factor * m[oi + l] * dy;
+                az[oj + l] -= factor * m[oi + l] * dz;
+            }
+        }
+    }
+
+    double* __restrict px = batch.x.data();
+    double* __restrict py = batch.y.data();
+    double* __restrict pz = batch.z.data();
+    double* __restrict vx = batch.vx.data();
+    double* __restrict vy = batch.vy.data();
+    double* __restrict vz = batch.vz.data();
+    const size_t count = n * L;
+    for (size_t k = 0; k < count; ++k) {
+        vx[k] += ax[k] * dt;
+        vy[k] += ay[k] * dt;
+        vz[k] += az[k] * dt;
+        px[k] += vx[k] * dt;
+        py[k] += vy[k] * dt;
+        pz[k] += vz[k] * dt;
+        ax[k] = ay[k] = az[k] = 0.0;
+    }
+}
+
+static void batchEnergy(const EnsembleBatch& batch, SofteningKernel kernel, double* energy) {
+    const int L = ENSEMBLE_LANES;
+    for (int l = 0; l < L; ++l) {
+        energy[l] = 0.0;
+    }
+    for (size_t i = 0; i < batch.bodies; ++i) {
+        for (int l = 0; l < L; ++l) {
+            size_t k = i * L + l;
+            double v2 = batch.vx[k] * batch.vx[k] + batch.vy[k] * batch.vy[k] + batch.vz[k] * batch.vz[k];
+            energy[l] += 0.5 * batch.mass[k] * v2;
+        }
+        for (size_t j = i + 1; j < batch.bodies; ++j) {
+            const double epsilon = pairSoftening(batch.softening[i], batch.softening[j]);
+            for (int l = 0; l < L; ++l) {
+                size_t a = i * L + l, b = j * L + l;
+                double dx = batch.x[b] - batch.x[a];
+                double dy = batch.y[b] - batch.y[a];
+                double dz = batch.z[b] - batch.z[a];
+                double r2 = dx*dx + dy*dy + dz*dz;
+                if (kernel == SOFTENING_CLAMP) {
+                    double dist = sqrt(r2);
+                    dist = dist < epsilon ? epsilon : dist;
+                    energy[l] -= G * batch.mass[a] * batch.mass[b] / dist;
+                } else {
+                    energy[l] -= G * batch.mass[a] * batch.mass[b] * softenedPotential(kernel, r2, epsilon);
+                }
+            }
+        }
+    }
+}
+
+// Perturbation gaussienne relative à la distance à l'origine et à la vitesse de chaque corps
+static void perturbMember(std::vector<BodyState>& states, double perturbation, unsigned int seed) {
+    std::mt19937 rng(seed);
+    std::normal_distribution<double> noise(0.0, perturbation);
+    for (auto& s : states) {
+        double r = sqrt(s.x * s.x + s.y * s.y + s.z * s.z);
+        double v = sqrt(s.vx * s.vx + s.vy * s.vy + s.vz * s.vz);
+        s.x += r * noise(rng);
+        s.y += r * noise(rng);
+        s.z += r * noise(rng);
+        s.vx += v * noise(rng);
+        s.vy += v * noise(rng);
+        s.vz += v * noise(rng);
+    }
+}
+
+std::vector<EnsembleSummary> simulateEnsemble(const std::vector<BodyState>& reference, const std::vector<double>& softening,
+                                              int members, long long steps, double dt, double perturbation,
+                                              unsigned int seed, int threads) {
+    const int L = ENSEMBLE_LANES;
+    std::vector<EnsembleSummary> summaries(members > 0 ? members : 0);
+    if (members <= 0 || reference.empty()) {
+        return summaries;
+    }
+    const size_t bodies = reference.size();
+    const size_t batchCount = (members + L - 1) / L;
+    const SofteningKernel kernel = softeningKernel();
+
+    parallelFor(batchCount, resolveThreadCount(threads), [&](size_t begin, size_t end, int) {
+        for (size_t batchIndex = begin; batchIndex < end; ++batchIndex) {
+            EnsembleBatch batch(bodies, softening);
+            for (int l = 0; l < L; ++l) {
+                // Les voies au-delà du dernier membre dupliquent la référence et sont ignorées
+                int member = static_cast<int>(batchIndex * L + l);
+                std::vector<BodyState> states = reference;
+                if (member > 0 && member < members) {
+                    perturbMember(states, perturbation, seed + member);
+                }
+                for (size_t b = 0; b < bodies; ++b) {
+                    size_t k = b * L + l;
+                    batch.x[k] = states[b].x;
+                    batch.y[k] = states[b].y;
+                    batch.z[k] = states[b].z;
+                    batch.vx[k] = states[b].vx;
+                    batch.vy[k] = states[b].vy;
+                    batch.vz[k] = states[b].vz;
+                    batch.mass[k] = states[b].mass;
+                }
+            }
+
+            double initialEnergy[ENSEMBLE_LANES], finalEnergy[ENSEMBLE_LANES];
+            batchEnergy(batch, kernel, initialEnergy);
+            for (long long s = 0; s < steps; ++s) {
+                stepBatch(batch, dt, kernel);
+            }
+            batchEnergy(batch, kernel, finalEnergy);
+
+            for (int l = 0; l < L; ++l) {
+                int member = static_cast<int>(batchIndex * L + l);
+                if (member >= members) {
+                    break;
+                }
+                EnsembleSummary& summary = summaries[member];
+                summary.member = member;
+                summary.energyError = fabs((finalEnergy[l] - initialEnergy[l]) / initialEnergy[l]);
+                summary.minSeparation = batch.minSeparation[l];
+                summary.hash = STATE_HASH_BASIS;
+                for (size_t b = 0; b < bodies; ++b) {
+                    size_t k = b * L + l;
+                    const double values[7] = { batch.x[k], batch.y[k], batch.z[k],
+                                               batch.vx[k], batch.vy[k], batch.vz[k], batch.mass[k] };
+                    hashDoubles(summary.hash, values, 7);
+                }
+            }
+        }
+    });
+    return summaries;
+}
+
+int runEnsemble(const SimulationOptions& options) {
+    std::vector<BodyState> reference = solarSystemInitialState();
+    std::vector<double> softening;
+    for (const auto& state : reference) {
+        softening.push_back(bodySoftening(state.radius, options.softeningLength, options.softeningRadius));
+    }
+
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    std::vector<EnsembleSummary> summaries = simulateEnsemble(reference, softening, options.ensembleMembers,
+                                                              options.ensembleSteps, options.dt,
+                                                              options.ensemblePerturbation, options.seed, options.threads);
+    double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::ofstream file;
+    if (options.ensembleOutput) {
+        file.open(options.ensembleOutput);
+        if (!file) {
+            std::cerr << "Failed to open ensemble output: " << options.ensembleOutput << std::endl;
+            return -1;
+        }
+    }
+    std::ostream& out = options.ensembleOutput ? static_cast<std::ostream&>(file) : std::cout;
+    out.precision(10);
+    out << "member,energy_error,min_separation_m,final_hash" << std::endl;
+    double worstEnergyError = 0.0;
+    for (const auto& summary : summaries) {
+        out << summary.member << ',' << summary.energyError << ',' << summary.minSeparation << ','
+            << std::hex << std::setw(16) << std::setfill('0') << summary.hash << std::dec << std::setfill(' ') << '\n';
+        worstEnergyError = std::max(worstEnergyError, summary.energyError);
+    }
+    out.flush();
+
+    std::cerr << "Ensemble: " << summaries.size() << " members x " << options.ensembleSteps << " steps in "
+              << elapsed << " s (worst energy error " << worstEnergyError << ")" << std::endl;
+    return 0;
+}
@@ -0,0 +1,33 @@
+// Ensemble.h
+#ifndef ENSEMBLE_H
+#define ENSEMBLE_H
+
+#include <vector>
+#include <cstdint>
+#include "SolarSystem.h"
+#include "Options.h"
+
+// Nombre de systèmes indépendants avancés ensemble : chaque corps occupe ENSEMBLE_LANES
+// valeurs contiguës (une par système), si bien que la boucle interne sur les systèmes
+// se vectorise sans dépendance entre voies.
+const int ENSEMBLE_LANES = 8;
+
+struct EnsembleSummary {
+    int member;
+    double energyError;   // Dérive relative de l'énergie totale entre le début et la fin
+    double minSeparation; // Plus petite distance observée entre deux corps (en mètres)
+    uint64_t hash;        // Empreinte de l'état final (même définition que stateHash)
+};
+
+// Intègre members copies perturbées de reference (le membre 0 n'est pas perturbé et
+// reproduit bit à bit la simulation interactive). Les lots de ENSEMBLE_LANES membres
+// sont répartis entre threads. softening : longueur d'adoucissement de chaque corps (noyau
+// softeningKernel()).
+std::vector<EnsembleSummary> simulateEnsemble(const std::vector<BodyState>& reference, const std::vector<double>& softening,
+                                              int members, long long steps, double dt, double perturbation,
+                                              unsigned int seed, int threads);
+
+// Mode --ensemble : simule le système solaire perturbé et écrit les résumés en CSV
+int runEnsemble(const SimulationOptions& options);
+
+#endif // ENSEMBLE_H
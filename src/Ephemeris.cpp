@@ -0,0 +1,245 @@
+// Ephemeris.cpp
+#include "Ephemeris.h"
+#include <cstring>
+#include <iostream>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+EphemerisWriter::EphemerisWriter() : file(nullptr), bodyCount(0) {
+}
+
+bool EphemerisWriter::open(const char* path, const std::vector<Planet>& planets, size_t definitionCount) {
+    // Les descriptions des corps suivent l'ordre des identifiants
+    for (size_t k = 0; k < planets.size(); ++k) {
+        if (planets[k].id != k) {
+            std::cerr << "Failed to open ephemeris file: bodies are not in creation order" << std::endl;
+            return false;
+        }
+    }
+    file = fopen(path, "wb");
+    if (!file) {
+        std::cerr << "Failed to open ephemeris file: " << path << std::endl;
+        return false;
+    }
+    bodyCount = planets.size();
+
+    EphemerisHeader header;
+    memcpy(header.magic, EPHEMERIS_MAGIC, sizeof(header.magic));
+    header.version = EPHEMERIS_VERSION;
+    header.bodyCount = static_cast<uint32_t>(bodyCount);
+    fwrite(&header, sizeof(header), 1, file);
+    for (size_t k = 0; k < bodyCount; ++k) {
+        const Planet& planet = planets[k];
+        EphemerisBody body = { planet.mass, planet.radius, planet.r, planet.g, planet.b,
+                               k < definitionCount ? static_cast<int32_t>(k) : -1 };
+        fwrite(&body, sizeof(body), 1, file);
+    }
+    record.resize(1 + 6 * bodyCount);
+    return true;
+}
+
+bool EphemerisWriter::isOpen() const {
+    return file != nullptr;
+}
+
+void EphemerisWriter::append(double time, const std::vector<Planet>& planets) {
+    if (!file) {
+        return;
+    }
+    if (planets.size() != bodyCount) {
+        std::cerr << "Body count changed, stopping ephemeris recording" << std::endl;
+        close();
+        return;
+    }
+    record[0] = time;
+    for (const auto& planet : planets) {
+        // Rangé par identifiant : le fichier garde l'ordre de création même si le tableau est réordonné
+        double* out = &record[1 + 6 * static_cast<size_t>(planet.id)];
+        out[0] = planet.x; out[1] = planet.y; out[2] = planet.z;
+        out[3] = planet.vx; out[4] = planet.vy; out[5] = planet.vz;
+    }
+    if (fwrite(record.data(), sizeof(double), record.size(), file) != record.size()) {
+        std::cerr << "Failed to write ephemeris sample" << std::endl;
+        close();
+    }
+}
+
+void EphemerisWriter::close() {
+    if (file) {
+        fclose(file);
+        file = nullptr;
+    }
+}
+
+EphemerisReader::EphemerisReader()
+    : mapping(nullptr), mappingSize(0), header(nullptr), bodies(nullptr), samples(nullptr), recordSize(0),
+      samplesCount(0) {
+}
+
+bool EphemerisReader::open(const char* path) {
+    int fd = ::open(path, O_RDONLY);
+    if (fd < 0) {
+        std::cerr << "Failed to open ephemeris file: " << path << std::endl;
+        return false;
+    }
+    struct stat info;
+    if (fstat(fd, &info) != 0 || static_cast<size_t>(info.st_size) < sizeof(EphemerisHeader)) {
+        std::cerr << "Invalid ephemeris file: " << path << std::endl;
+        ::close(fd);
+        return false;
+    }
+    mappingSize = static_cast<size_t>(info.st_size);
+    mapping = mmap(nullptr, mappingSize, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd); // La projection reste valide après la fermeture du descripteur
+    if (mapping == MAP_FAILED) {
+        std::cerr << "Failed to map ephemeris file: " << path << std::endl;
+        mapping = nullptr;
+        return false;
+    }
+
+    const unsigned char* base = static_cast<const unsigned char*>(mapping);
+    header = reinterpret_cast<const EphemerisHeader*>(base);
+    size_t bodiesEnd = sizeof(EphemerisHeader) + header->bodyCount * sizeof(EphemerisBody);
+    if (memcmp(header->magic, EPHEMERIS_MAGIC, sizeof(header->magic)) != 0 || header->version != EPHEMERIS_VERSION ||
+        header->bodyCount == 0 || bodiesEnd > mappingSize) {
+        std::cerr << "Invalid ephemeris file: " << path << std::endl;
+        close();
+        return false;
+    }
+    bodies = reinterpret_cast<const EphemerisBody*>(base + sizeof(EphemerisHeader));
+    samples = base + bodiesEnd;
+    recordSize = (1 + 6 * header->bodyCount) * sizeof(double);
+    samplesCount = (mappingSize - bodiesEnd) / recordSize; // Un dernier enregistrement incomplet est ignoré
+    if (samplesCount == 0) {
+        std::cerr << "Ephemeris file has no samples: " << path << std::endl;
+        close();
+        return false;
+    }
+    return true;
+}
+
+void EphemerisReader::close() {
+    if (mapping) {
+        munmap(mapping, mappingSize);
+    }
+    mapping = nullptr;
+    mappingSize = 0;
+    header = nullptr;
+    bodies = nullptr;
+    samples = nullptr;
+    samplesCount = 0;
+}
+
+bool EphemerisReader::isOpen() const {
+    return mapping != nullptr;
+}
+
+size_t EphemerisReader::bodyCount() const {
+    return header ? header->bodyCount : 0;
+}
+
+size_t EphemerisReader::sampleCount() const {
+    return samplesCount;
+}
+
+const EphemerisBody& EphemerisReader::body(size_t index) const {
+    return bodies[index];
+}
+
+const double* EphemerisReader::sampleRecord(size_t sample) const {
+    return reinterpret_cast<const double*>(samples + sample * recordSize);
+}
+
+double EphemerisReader::time(size_t sample) const {
+    return sampleRecord(sample)[0];
+}
+
+const double* EphemerisReader::sampleState(size_t sample, size_t body) const {
+    return sampleRecord(sample) + 1 + 6 * body;
+}
+
+double EphemerisReader::startTime() const {
+    return time(0);
+}
+
+double EphemerisReader::endTime() const {
+    return time(samplesCount - 1);
+}
+
+size_t EphemerisReader::findSample(double t) const {
+    if (samplesCount < 2) {
+        return 0;
+    }
+    // Recherche dichotomique : les échantillons ne sont pas forcément régulièrement espacés
+    size_t lo = 0, hi = samplesCount - 1;
+    while (hi - lo > 1) {
+        size_t mid = lo + (hi - lo) / 2;
+        if (time(mid) <= t) {
+            lo = mid;
+        } else {
+            hi = mid;
+        }
+    }
+    return lo;
+}
+
+// Bases d'Hermite cubiques entre deux échantillons et leurs dérivées (par rapport à s)
+struct HermiteBasis {
+    double h;
+    double h00, h10, h01, h11;
+    double d00, d10, d01, d11;
+};
+
+static void hermiteBasis(double t0, double t1, double t, HermiteBasis& basis) {
+    double h = t1 - t0;
+    double s = h > 0.0 ? (t - t0) / h : 0.0;
+    if (s < 0.0) s = 0.0;
+    if (s > 1.0) s = 1.0;
+    double s2 = s * s, s3 = s2 * s;
+    basis.h = h;
+    basis.h00 = 2 * s3 - 3 * s2 + 1;
+    basis.h10 = s3 - 2 * s2 + s;
+    basis.h01 = -2 * s3 + 3 * s2;
+    basis.h11 = s3 - s2;
+    basis.d00 = 6 * s2 - 6 * s;
+    basis.d10 = 3 * s2 - 4 * s + 1;
+    basis.d01 = -6 * s2 + 6 * s;
+    basis.d11 = 3 * s2 - 2 * s;
+}
+
+static void hermiteInterpolate(const HermiteBasis& basis, const double* a, const double* b, double* out) {
+    double h = basis.h;
+    for (int c = 0; c < 3; ++c) {
+        double p0 = a[c], v0 = a[3 + c], p1 = b[c], v1 = b[3 + c];
+        out[c] = basis.h00 * p0 + basis.h10 * h * v0 + basis.h01 * p1 + basis.h11 * h * v1;
+        out[3 + c] = h > 0.0 ? (basis.d00 * p0 + basis.d01 * p1) / h + basis.d10 * v0 + basis.d11 * v1 : v0;
+    }
+}
+
+void EphemerisReader::evaluate(double t, std::vector<double>& states) const {
+    size_t n = bodyCount();
+    states.resize(6 * n);
+    if (samplesCount < 2) {
+        memcpy(states.data(), sampleState(0, 0), 6 * n * sizeof(double));
+        return;
+    }
+    size_t k = findSample(t);
+    HermiteBasis basis;
+    hermiteBasis(time(k), time(k + 1), t, basis);
+    for (size_t body = 0; body < n; ++body) {
+        hermiteInterpolate(basis, sampleState(k, body), sampleState(k + 1, body), &states[6 * body]);
+    }
+}
+
+void EphemerisReader::evaluateBody(double t, size_t body, double state[6]) const {
+    if (samplesCount < 2) {
+        memcpy(state, sampleState(0, body), 6 * sizeof(double));
+        return;
+    }
+    size_t k = findSample(t);
+    HermiteBasis basis;
+    hermiteBasis(time(k), time(k + 1), t, basis);
+    hermiteInterpolate(basis, sampleState(k, body), sampleState(k + 1, body), state);
+}
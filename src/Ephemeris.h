@@ -0,0 +1,88 @@
+// Ephemeris.h
+#ifndef EPHEMERIS_H
+#define EPHEMERIS_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+#include "Planet.h"
+
+// Fichier d'éphémérides échantillonnées : en-tête, description des corps, puis un enregistrement
+// de taille fixe par échantillon (temps, puis x, y, z, vx, vy, vz de chaque corps en m et m/s).
+// Le nombre d'échantillons se déduit de la taille du fichier : un enregistrement interrompu reste lisible.
+const char EPHEMERIS_MAGIC[8] = { 'S', 'S', 'E', 'P', 'H', 'E', 'M', '\0' };
+const uint32_t EPHEMERIS_VERSION = 1;
+
+struct EphemerisHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t bodyCount;
+};
+
+struct EphemerisBody {
+    double mass;        // En kg
+    double radius;      // En mètres
+    float r, g, b;      // Couleur
+    int32_t definition; // Indice dans solarSystemDefinition(), -1 pour un corps généré
+};
+
+class EphemerisWriter {
+public:
+    EphemerisWriter();
+
+    // Les definitionCount premiers corps sont ceux de solarSystemDefinition()
+    bool open(const char* path, const std::vector<Planet>& planets, size_t definitionCount);
+    bool isOpen() const;
+
+    // Le nombre de corps doit rester celui de open() ; sinon l'enregistrement s'arrête.
+    // Les états sont écrits dans l'ordre des identifiants, quel que soit l'ordre du tableau.
+    void append(double time, const std::vector<Planet>& planets);
+    void close();
+
+private:
+    FILE* file;
+    size_t bodyCount;
+    std::vector<double> record;
+};
+
+// Lecture par projection en mémoire (mmap) : rien n'est copié ni analysé au chargement
+class EphemerisReader {
+public:
+    EphemerisReader();
+
+    bool open(const char* path);
+    void close();
+    bool isOpen() const;
+
+    size_t bodyCount() const;
+    size_t sampleCount() const;
+    const EphemerisBody& body(size_t index) const;
+    double time(size_t sample) const;
+    double startTime() const;
+    double endTime() const;
+
+    // Dernier échantillon dont le temps est inférieur ou égal à t (borné au premier et à l'avant-dernier)
+    size_t findSample(double t) const;
+
+    // Position et vitesse de chaque corps à l'instant t (6 valeurs par corps), par interpolation
+    // d'Hermite cubique entre les deux échantillons qui l'encadrent ; t est borné à l'intervalle enregistré
+    void evaluate(double t, std::vector<double>& states) const;
+    void evaluateBody(double t, size_t body, double state[6]) const;
+
+    // État enregistré du corps dans un échantillon (x, y, z, vx, vy, vz)
+    const double* sampleState(size_t sample, size_t body) const;
+
+private:
+    const double* sampleRecord(size_t sample) const;
+
+    void* mapping;
+    size_t mappingSize;
+    const EphemerisHeader* header;
+    const EphemerisBody* bodies;
+    const unsigned char* samples;
+    size_t recordSize;
+    size_t samplesCount;
+};
+
+#endif // EPHEMERIS_H
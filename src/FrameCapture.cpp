@@ -0,0 +1,227 @@
+// FrameCapture.cpp
+#include "FrameCapture.h"
+#include "Options.h"
+#include "Profiler.h"
+#include <cstring>
+#include <iostream>
+
+FrameCapture::FrameCapture()
+    : width(0), height(0), frameBytes(0), fbo(0), colorBuffer(0), depthBuffer(0), issued(0),
+      output(nullptr), pipe(false), stopping(false) {
+    for (int k = 0; k < PBO_COUNT; ++k) {
+        pbos[k] = 0;
+    }
+}
+
+bool FrameCapture::open(const char* target, int w, int h) {
+    width = w;
+    height = h;
+    frameBytes = static_cast<size_t>(w) * h * 4;
+
+    if (target[0] == '|') {
+        output = popen(target + 1, "w");
+        pipe = true;
+    } else if (strchr(target, '%')) {
+        pattern = target; // Un fichier par image, ouvert par le thread d'écriture
+    } else {
+        output = fopen(target, "wb");
+    }
+    if (pattern.empty() && !output) {
+        std::cerr << "Failed to open capture target: " << target << std::endl;
+        return false;
+    }
+
+    glGenFramebuffers(1, &fbo);
+    glGenRenderbuffers(1, &colorBuffer);
+    glGenRenderbuffers(1, &depthBuffer);
+    glBindRenderbuffer(GL_RENDERBUFFER, colorBuffer);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_RGBA8, w, h);
+    glBindRenderbuffer(GL_RENDERBUFFER, depthBuffer);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT24, w, h);
+    glBindRenderbuffer(GL_RENDERBUFFER, 0);
+    glBindFramebuffer(GL_FRAMEBUFFER, fbo);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, colorBuffer);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_RENDERBUFFER, depthBuffer);
+    GLenum status = glCheckFramebufferStatus(GL_FRAMEBUFFER);
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    if (status != GL_FRAMEBUFFER_COMPLETE) {
+        std::cerr << "Failed to create capture framebuffer (status 0x" << std::hex << status << std::dec << ")" << std::endl;
+        close();
+        return false;
+    }
+
+    glGenBuffers(PBO_COUNT, pbos);
+    for (int k = 0; k < PBO_COUNT; ++k) {
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, pbos[k]);
+        glBufferData(GL_PIXEL_PACK_BUFFER, frameBytes, nullptr, GL_STREAM_READ);
+    }
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+    stopping = false;
+    writer = std::thread(&FrameCapture::writerLoop, this);
+    return true;
+}
+
+bool FrameCapture::active() const {
+    return fbo != 0;
+}
+
+long long FrameCapture::frames() const {
+    return issued;
+}
+
+void FrameCapture::beginFrame() {
+    glBindFramebuffer(GL_FRAMEBUFFER, fbo);
+    glViewport(0, 0, width, height);
+}
+
+void FrameCapture::endFrame() {
+    // Relecture asynchrone : glReadPixels vers un PBO retourne sans attendre le GPU
+    GLuint pbo = pbos[issued % PBO_COUNT];
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, fbo);
+    glReadBuffer(GL_COLOR_ATTACHMENT0);
+    glPixelStorei(GL_PACK_ALIGNMENT, 1);
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, pbo);
+    glReadPixels(0, 0, width, height, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+    ++issued;
+
+    // La plus ancienne relecture de l'anneau est terminée depuis PBO_COUNT - 1 images
+    if (issued >= PBO_COUNT) {
+        submit(pbos[issued % PBO_COUNT]);
+    }
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+}
+
+void FrameCapture::present(int windowWidth, int windowHeight) {
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, fbo);
+    glBindFramebuffer(GL_DRAW_FRAMEBUFFER, 0);
+    glBlitFramebuffer(0, 0, width, height, 0, 0, windowWidth, windowHeight, GL_COLOR_BUFFER_BIT, GL_LINEAR);
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    glViewport(0, 0, windowWidth, windowHeight);
+}
+
+// Copie le contenu d'un PBO (lignes de bas en haut) dans un tampon retourné pour le thread d'écriture
+void FrameCapture::submit(GLuint pbo) {
+    std::vector<unsigned char> frame;
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        if (pending.size() >= MAX_PENDING) {
+            profilerAdd(PROFILE_CAPTURE_STALLS);
+            drained.wait(lock, [this] { return pending.size() < MAX_PENDING; });
+        }
+        if (!spare.empty()) {
+            frame.swap(spare.back());
+            spare.pop_back();
+        }
+    }
+    frame.resize(frameBytes);
+
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, pbo);
+    const unsigned char* pixels = static_cast<const unsigned char*>(
+        glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0, frameBytes, GL_MAP_READ_BIT));
+    if (!pixels) {
+        std::cerr << "Failed to map capture buffer" << std::endl;
+        return;
+    }
+    size_t rowBytes = static_cast<size_t>(width) * 4;
+    for (int y = 0; y < height; ++y) {
+        memcpy(&frame[y * rowBytes], pixels + (height - 1 - y) * rowBytes, rowBytes);
+    }
+    glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        pending.push_back(std::vector<unsigned char>());
+        pending.back().swap(frame);
+    }
+    ready.notify_one();
+}
+
+void FrameCapture::writerLoop() {
+    long long index = 0;
+    for (;;) {
+        std::vector<unsigned char> frame;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            ready.wait(lock, [this] { return stopping || !pending.empty(); });
+            if (pending.empty()) {
+                return; // Arrêt demandé et plus rien à écrire
+            }
+            frame.swap(pending.front());
+            pending.pop_front();
+        }
+        drained.notify_one();
+
+        writeFrame(frame, index++);
+
+        std::lock_guard<std::mutex> lock(mutex);
+        spare.push_back(std::vector<unsigned char>());
+        spare.back().swap(frame);
+    }
+}
+
+void FrameCapture::writeFrame(const std::vector<unsigned char>& pixels, long long index) {
+    if (pattern.empty()) {
+        if (fwrite(pixels.data(), 1, pixels.size(), output) != pixels.size()) {
+            std::cerr << "Failed to write capture frame " << index << std::endl;
+        }
+        return;
+    }
+
+    // Séquence d'images : PPM binaire, sans canal alpha
+    std::string path = framePath(pattern, index);
+    FILE* file = fopen(path.c_str(), "wb");
+    if (!file) {
+        std::cerr << "Failed to open capture frame: " << path << std::endl;
+        return;
+    }
+    fprintf(file, "P6\n%d %d\n255\n", width, height);
+    std::vector<unsigned char> rgb(static_cast<size_t>(width) * height * 3);
+    for (size_t p = 0, n = static_cast<size_t>(width) * height; p < n; ++p) {
+        rgb[p * 3] = pixels[p * 4];
+        rgb[p * 3 + 1] = pixels[p * 4 + 1];
+        rgb[p * 3 + 2] = pixels[p * 4 + 2];
+    }
+    fwrite(rgb.data(), 1, rgb.size(), file);
+    fclose(file);
+}
+
+void FrameCapture::close() {
+    if (writer.joinable()) {
+        // Récupérer les relectures encore en vol dans l'anneau
+        long long first = issued >= PBO_COUNT ? issued - PBO_COUNT + 1 : 0;
+        for (long long k = first; k < issued; ++k) {
+            submit(pbos[k % PBO_COUNT]);
+        }
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        ready.notify_one();
+        writer.join();
+    }
+
+    if (output) {
+        if (pipe) {
+            pclose(output);
+        } else {
+            fclose(output);
+        }
+        output = nullptr;
+    }
+    if (pbos[0]) {
+        glDeleteBuffers(PBO_COUNT, pbos);
+    }
+    glDeleteRenderbuffers(1, &colorBuffer);
+    glDeleteRenderbuffers(1, &depthBuffer);
+    glDeleteFramebuffers(1, &fbo);
+    for (int k = 0; k < PBO_COUNT; ++k) {
+        pbos[k] = 0;
+    }
+    fbo = colorBuffer = depthBuffer = 0;
+    pending.clear();
+    spare.clear();
+}
@@ -0,0 +1,61 @@
+// FrameCapture.h
+#ifndef FRAME_CAPTURE_H
+#define FRAME_CAPTURE_H
+
+#include <condition_variable>
+#include <cstdio>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include <GL/glew.h>
+
+// Rendu hors écran (FBO couleur + profondeur) et relecture asynchrone des images.
+// Chaque image est copiée dans un PBO d'un anneau de PBO_COUNT tampons ; elle n'est mappée que
+// PBO_COUNT - 1 images plus tard, quand le GPU a terminé, puis confiée à un thread d'écriture.
+// Cibles : fichier d'images RGBA brutes (première ligne en haut), commande "|cmd" recevant le même
+// flux sur son entrée standard, ou motif contenant %d pour une séquence d'images PPM.
+class FrameCapture {
+public:
+    FrameCapture();
+
+    // Contexte OpenGL requis (3.0 ou ARB_framebuffer_object) ; false si la cible ou le FBO échoue
+    bool open(const char* target, int width, int height);
+    bool active() const;
+    long long frames() const; // Images capturées, y compris celles encore dans l'anneau
+
+    void beginFrame(); // Lie le FBO et ajuste le viewport à la taille de capture
+    void endFrame();   // Lance la relecture de l'image rendue, transmet les images prêtes
+    void present(int windowWidth, int windowHeight); // Copie l'image dans la fenêtre (si visible)
+
+    // Vide l'anneau, attend la fin des écritures et libère les ressources
+    void close();
+
+private:
+    static const int PBO_COUNT = 3;
+    static const size_t MAX_PENDING = 8; // Au-delà, le rendu attend le thread d'écriture
+
+    void submit(GLuint pbo);
+    void writerLoop();
+    void writeFrame(const std::vector<unsigned char>& pixels, long long index);
+
+    int width, height;
+    size_t frameBytes;
+    GLuint fbo, colorBuffer, depthBuffer;
+    GLuint pbos[PBO_COUNT];
+    long long issued; // Relectures lancées
+
+    FILE* output;
+    bool pipe;
+    std::string pattern;
+
+    std::thread writer;
+    std::mutex mutex;
+    std::condition_variable ready, drained;
+    std::deque<std::vector<unsigned char> > pending;
+    std::vector<std::vector<unsigned char> > spare; // Tampons réutilisés
+    bool stopping;
+};
+
+#endif // FRAME_CAPTURE_H
@@ -0,0 +1,35 @@
+// FrameTimer.cpp
+#include "FrameTimer.h"
+#include <algorithm>
+#include <iostream>
+
+void FrameTimer::start() {
+    begin = std::chrono::steady_clock::now();
+}
+
+void FrameTimer::stop() {
+    samples.push_back(std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - begin).count());
+}
+
+size_t FrameTimer::count() const {
+    return samples.size();
+}
+
+double FrameTimer::last() const {
+    return samples.empty() ? 0.0 : samples.back();
+}
+
+void FrameTimer::report(const char* label) const {
+    if (samples.empty()) {
+        return;
+    }
+    std::vector<double> sorted = samples;
+    std::sort(sorted.begin(), sorted.end());
+    double sum = 0.0;
+    for (double sample : sorted) {
+        sum += sample;
+    }
+    std::cout << label << ": " << sorted.size() << " frames, mean " << sum / sorted.size() << " ms, median "
+              << sorted[sorted.size() / 2] << " ms, p95 " << sorted[sorted.size() * 95 / 100] << " ms, max "
+              << sorted.back() << " ms" << std::endl;
+}
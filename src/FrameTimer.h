@@ -0,0 +1,26 @@
+// FrameTimer.h
+#ifndef FRAME_TIMER_H
+#define FRAME_TIMER_H
+
+#include <chrono>
+#include <cstddef>
+#include <vector>
+
+// Mesure des temps d'image (en millisecondes) pour comparer les chemins de rendu
+class FrameTimer {
+public:
+    void start();
+    void stop(); // Enregistre la durée écoulée depuis start()
+
+    size_t count() const;
+    double last() const;
+
+    // Moyenne, médiane, 95e centile et maximum sur la sortie standard
+    void report(const char* label) const;
+
+private:
+    std::chrono::steady_clock::time_point begin;
+    std::vector<double> samples;
+};
+
+#endif // FRAME_TIMER_H
@@ -0,0 +1,59 @@
+// Frustum.cpp
+#include "Frustum.h"
+#include <cmath>
+
+void Frustum::extract(const double projection[16], const double modelview[16]) {
+    // clip = projection * modelview, en ordre colonne : clip[col * 4 + row]
+    double clip[16];
+    for (int col = 0; col < 4; ++col) {
+        for (int row = 0; row < 4; ++row) {
+            double sum = 0.0;
+            for (int k = 0; k < 4; ++k) {
+                sum += projection[k * 4 + row] * modelview[col * 4 + k];
+            }
+            clip[col * 4 + row] = sum;
+        }
+    }
+
+    // Méthode de Gribb et Hartmann : ligne 3 ± lignes 0, 1, 2
+    for (int p = 0; p < 6; ++p) {
+        int row = p / 2;
+        double sign = (p % 2 == 0) ? 1.0 : -1.0;
+        double length = 0.0;
+        for (int col = 0; col < 4; ++col) {
+            planes[p][col] = clip[col * 4 + 3] + sign * clip[col * 4 + row];
+            if (col < 3) {
+                length += planes[p][col] * planes[p][col];
+            }
+        }
+        length = sqrt(length);
+        if (length > 0.0) {
+            for (int col = 0; col < 4; ++col) {
+                planes[p][col] /= length;
+            }
+        }
+    }
+}
+
+bool Frustum::containsSphere(double x, double y, double z, double radius) const {
+    for (int p = 0; p < 6; ++p) {
+        if (planes[p][0] * x + planes[p][1] * y + planes[p][2] * z + planes[p][3] < -radius) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool Frustum::containsBox(const double lo[3], const double hi[3]) const {
+    for (int p = 0; p < 6; ++p) {
+        // Le coin le plus avancé dans la direction de la normale
+        double distance = planes[p][3];
+        for (int c = 0; c < 3; ++c) {
+            distance += planes[p][c] * (planes[p][c] >= 0.0 ? hi[c] : lo[c]);
+        }
+        if (distance < 0.0) {
+            return false;
+        }
+    }
+    return true;
+}
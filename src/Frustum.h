@@ -0,0 +1,19 @@
+// Frustum.h
+#ifndef FRUSTUM_H
+#define FRUSTUM_H
+
+// Pyramide de vision : six plans (a, b, c, d) normalisés, normales vers l'intérieur
+struct Frustum {
+    double planes[6][4];
+
+    // Extraire les plans de projection * modèle-vue (matrices OpenGL, ordre colonne)
+    void extract(const double projection[16], const double modelview[16]);
+
+    // Faux seulement si la sphère est entièrement hors d'un des plans
+    bool containsSphere(double x, double y, double z, double radius) const;
+
+    // Faux seulement si la boîte alignée sur les axes est entièrement hors d'un des plans
+    bool containsBox(const double lo[3], const double hi[3]) const;
+};
+
+#endif // FRUSTUM_H
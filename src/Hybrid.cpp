@@ -0,0 +1,302 @@
+// Hybrid.cpp
+#include "Hybrid.h"
+#include "Arena.h"
+#include "Collision.h"
+#include "Parallel.h"
+#include "Physics.h"
+#include "Scheduler.h"
+#include <algorithm>
+#include <cmath>
+
+struct EncounterEntry {
+    double lo, hi; // Intervalle parcouru pendant le pas sur l'axe de tri, rayon de rencontre compris
+    size_t index;
+};
+
+static bool encounterEntryLess(const EncounterEntry& a, const EncounterEntry& b) {
+    return a.lo < b.lo;
+}
+
+static double axisComponent(const Planet& p, int axis, bool velocity) {
+    if (velocity) {
+        return axis == 0 ? p.vx : (axis == 1 ? p.vy : p.vz);
+    }
+    return axis == 0 ? p.x : (axis == 1 ? p.y : p.z);
+}
+
+// Accélération de i due à j : G m_j f (x_j - x_i), f du noyau d'adoucissement courant
+static inline void pairAcceleration(SofteningKernel kernel, const double* xi, const double* xj, double massJ,
+                                    double epsilon, double* a) {
+    double dx = xj[0] - xi[0], dy = xj[1] - xi[1], dz = xj[2] - xi[2];
+    double f = G * massJ * softenedForceFactor(kernel, dx * dx + dy * dy + dz * dz, epsilon);
+    a[0] += f * dx;
+    a[1] += f * dy;
+    a[2] += f * dz;
+}
+
+static size_t findRoot(std::vector<size_t>& parent, size_t k) {
+    while (parent[k] != k) {
+        parent[k] = parent[parent[k]];
+        k = parent[k];
+    }
+    return k;
+}
+
+HybridIntegrator::HybridIntegrator(double hillFactor, double epsilon, double minimum)
+    : hillFactor(hillFactor), epsilon(epsilon), minimum(minimum), totalValid(false), pairCount(0), groupCount(0) {
+}
+
+size_t HybridIntegrator::closePairs() const {
+    return pairCount;
+}
+
+size_t HybridIntegrator::groups() const {
+    return groupCount;
+}
+
+void HybridIntegrator::reset() {
+    totalValid = false;
+    groupIntegrators.clear();
+}
+
+void HybridIntegrator::findClosePairs(const std::vector<Planet>& planets, double dt, std::vector<ClosePair>& pairs) const {
+    pairs.clear();
+    const size_t n = planets.size();
+    if (n < 2) {
+        return;
+    }
+
+    // Rayons de Hill par rapport au corps le plus massif
+    size_t central = 0;
+    for (size_t k = 1; k < n; ++k) {
+        if (planets[k].mass > planets[central].mass) {
+            central = k;
+        }
+    }
+    const Planet& sun = planets[central];
+    double* reach = stepArena().allocateArray<double>(n);
+    for (size_t k = 0; k < n; ++k) {
+        const Planet& p = planets[k];
+        double hill = 0.0;
+        if (k != central && sun.mass > 0.0) {
+            double dx = p.x - sun.x, dy = p.y - sun.y, dz = p.z - sun.z;
+            hill = sqrt(dx * dx + dy * dy + dz * dz) * cbrt(p.mass / (3.0 * sun.mass));
+        }
+        reach[k] = std::max(p.radius, hillFactor * hill);
+    }
+
+    // Balayage et élagage sur le mouvement en ligne droite du pas
+    int axis = sweepAxis(planets);
+    EncounterEntry* entries = stepArena().allocateArray<EncounterEntry>(n);
+    for (size_t k = 0; k < n; ++k) {
+        double start = axisComponent(planets[k], axis, false);
+        double end = start + axisComponent(planets[k], axis, true) * dt;
+        entries[k].lo = std::min(start, end) - reach[k];
+        entries[k].hi = std::max(start, end) + reach[k];
+        entries[k].index = k;
+    }
+    std::sort(entries, entries + n, encounterEntryLess);
+
+    for (size_t a = 0; a < n; ++a) {
+        for (size_t b = a + 1; b < n && entries[b].lo <= entries[a].hi; ++b) {
+            size_t i = std::min(entries[a].index, entries[b].index);
+            size_t j = std::max(entries[a].index, entries[b].index);
+            const Planet& p = planets[i];
+            const Planet& q = planets[j];
+            if (p.mass == 0.0 && q.mass == 0.0) {
+                continue;
+            }
+            // Plus courte distance pendant le pas, mouvement relatif en ligne droite
+            double sx = q.x - p.x, sy = q.y - p.y, sz = q.z - p.z;
+            double wx = (q.vx - p.vx) * dt, wy = (q.vy - p.vy) * dt, wz = (q.vz - p.vz) * dt;
+            double w2 = wx * wx + wy * wy + wz * wz;
+            double t = w2 > 0.0 ? std::min(1.0, std::max(0.0, -(sx * wx + sy * wy + sz * wz) / w2)) : 0.0;
+            double cx = sx + wx * t, cy = sy + wy * t, cz = sz + wz * t;
+            double radius = std::max(reach[i], reach[j]);
+            if (cx * cx + cy * cy + cz * cz < radius * radius) {
+                ClosePair pair = { i, j };
+                pairs.push_back(pair);
+            }
+        }
+    }
+    std::sort(pairs.begin(), pairs.end(), [](const ClosePair& a, const ClosePair& b) {
+        return a.i != b.i ? a.i < b.i : a.j < b.j;
+    });
+}
+
+double HybridIntegrator::step(std::vector<Planet>& planets, const SimulationOptions& options, double* potential) {
+    const double dt = options.dt;
+    const size_t n = planets.size();
+    const int threads = resolveThreadCount(options.threads);
+    const SofteningKernel kernel = softeningKernel();
+
+    // Passe de forces habituelle, toutes paires comprises, rangée dans total
+    TaskGraph graph;
+    auto forcePass = [&](double* energy) {
+        graph.clear();
+        addForceTasks(graph, planets, options.forceMethod, options.theta, options.threads, options.deterministic,
+                      energy);
+        graph.run(threads);
+        total.resize(n * 3);
+        parallelFor(n, threads, [&](size_t begin, size_t end, int) {
+            for (size_t k = begin; k < end; ++k) {
+                Planet& p = planets[k];
+                total[k * 3] = p.ax;
+                total[k * 3 + 1] = p.ay;
+                total[k * 3 + 2] = p.az;
+                p.ax = p.ay = p.az = 0.0;
+            }
+        });
+        totalValid = true;
+    };
+    if (!totalValid || total.size() != n * 3 || potential) {
+        forcePass(potential);
+    }
+
+    std::vector<ClosePair> pairs;
+    findClosePairs(planets, dt, pairs);
+
+    // Demi-impulsion des forces lointaines : le total, moins les paires proches aux positions courantes
+    auto kick = [&]() {
+        const double half = 0.5 * dt;
+        parallelFor(n, threads, [&](size_t begin, size_t end, int) {
+            for (size_t k = begin; k < end; ++k) {
+                planets[k].vx += total[k * 3] * half;
+                planets[k].vy += total[k * 3 + 1] * half;
+                planets[k].vz += total[k * 3 + 2] * half;
+            }
+        });
+        for (const ClosePair& pair : pairs) {
+            Planet& p = planets[pair.i];
+            Planet& q = planets[pair.j];
+            double xi[3] = { p.x, p.y, p.z }, xj[3] = { q.x, q.y, q.z };
+            double epsilon = pairSoftening(p.softening, q.softening);
+            double ai[3] = { 0.0, 0.0, 0.0 }, aj[3] = { 0.0, 0.0, 0.0 };
+            pairAcceleration(kernel, xi, xj, q.mass, epsilon, ai);
+            pairAcceleration(kernel, xj, xi, p.mass, epsilon, aj);
+            p.vx -= ai[0] * half;
+            p.vy -= ai[1] * half;
+            p.vz -= ai[2] * half;
+            q.vx -= aj[0] * half;
+            q.vy -= aj[1] * half;
+            q.vz -= aj[2] * half;
+        }
+    };
+    kick();
+
+    // Groupes de rencontre : corps reliés par des paires proches, dans l'ordre des indices
+    std::vector<size_t> parent(n);
+    for (size_t k = 0; k < n; ++k) {
+        parent[k] = k;
+    }
+    for (const ClosePair& pair : pairs) {
+        parent[findRoot(parent, pair.j)] = findRoot(parent, pair.i);
+    }
+    std::vector<char> encountered(n, 0);
+    for (const ClosePair& pair : pairs) {
+        encountered[pair.i] = encountered[pair.j] = 1;
+    }
+    std::vector<int> groupOf(n, -1), groupOfRoot(n, -1), localIndex(n, -1);
+    std::vector<std::vector<size_t> > members;
+    std::vector<std::vector<ClosePair> > groupPairs;
+    for (size_t k = 0; k < n; ++k) {
+        if (!encountered[k]) {
+            continue;
+        }
+        size_t root = findRoot(parent, k);
+        if (groupOfRoot[root] < 0) {
+            groupOfRoot[root] = static_cast<int>(members.size());
+            members.emplace_back();
+            groupPairs.emplace_back();
+        }
+        groupOf[k] = groupOfRoot[root];
+        localIndex[k] = static_cast<int>(members[groupOf[k]].size());
+        members[groupOf[k]].push_back(k);
+    }
+    for (const ClosePair& pair : pairs) {
+        ClosePair local = { static_cast<size_t>(localIndex[pair.i]), static_cast<size_t>(localIndex[pair.j]) };
+        groupPairs[groupOf[pair.i]].push_back(local);
+    }
+
+    // Un intégrateur par groupe, repris d'un pas à l'autre tant que le groupe ne change pas
+    std::map<std::vector<unsigned int>, Ias15Integrator> kept;
+    std::vector<Ias15Integrator*> integrators(members.size());
+    for (size_t g = 0; g < members.size(); ++g) {
+        std::vector<unsigned int> ids;
+        for (size_t k : members[g]) {
+            ids.push_back(planets[k].id);
+        }
+        std::sort(ids.begin(), ids.end());
+        auto previous = groupIntegrators.find(ids);
+        auto inserted = previous != groupIntegrators.end()
+            ? kept.insert(std::make_pair(ids, previous->second))
+            : kept.insert(std::make_pair(ids, Ias15Integrator(epsilon, dt, std::min(minimum, dt), dt)));
+        integrators[g] = &inserted.first->second;
+    }
+    groupIntegrators.swap(kept);
+
+    // Dérive : en ligne droite hors rencontre, IAS15 sous les seules paires proches dans un groupe
+    parallelFor(n, threads, [&](size_t begin, size_t end, int) {
+        for (size_t k = begin; k < end; ++k) {
+            if (groupOf[k] < 0) {
+                Planet& p = planets[k];
+                p.x += p.vx * dt;
+                p.y += p.vy * dt;
+                p.z += p.vz * dt;
+            }
+        }
+    });
+    parallelFor(members.size(), threads, [&](size_t begin, size_t end, int) {
+        for (size_t g = begin; g < end; ++g) {
+            const std::vector<size_t>& group = members[g];
+            const std::vector<ClosePair>& local = groupPairs[g];
+            const size_t m = group.size();
+            std::vector<double> position(m * 3), velocity(m * 3), mass(m), softening(m);
+            for (size_t l = 0; l < m; ++l) {
+                const Planet& p = planets[group[l]];
+                position[l * 3] = p.x;
+                position[l * 3 + 1] = p.y;
+                position[l * 3 + 2] = p.z;
+                velocity[l * 3] = p.vx;
+                velocity[l * 3 + 1] = p.vy;
+                velocity[l * 3 + 2] = p.vz;
+                mass[l] = p.mass;
+                softening[l] = p.softening;
+            }
+            AccelerationFunction accelerations = [&](const double* x, double* a) {
+                std::fill(a, a + m * 3, 0.0);
+                for (const ClosePair& pair : local) {
+                    double epsilon = pairSoftening(softening[pair.i], softening[pair.j]);
+                    pairAcceleration(kernel, &x[pair.i * 3], &x[pair.j * 3], mass[pair.j], epsilon, &a[pair.i * 3]);
+                    pairAcceleration(kernel, &x[pair.j * 3], &x[pair.i * 3], mass[pair.i], epsilon, &a[pair.j * 3]);
+                }
+            };
+            for (double remaining = dt; remaining > 0.0;) {
+                remaining -= integrators[g]->integrate(position, velocity, accelerations, remaining);
+            }
+            for (size_t l = 0; l < m; ++l) {
+                Planet& p = planets[group[l]];
+                p.x = position[l * 3];
+                p.y = position[l * 3 + 1];
+                p.z = position[l * 3 + 2];
+                p.vx = velocity[l * 3];
+                p.vy = velocity[l * 3 + 1];
+                p.vz = velocity[l * 3 + 2];
+            }
+        }
+    });
+
+    // Forces de fin de pas, reprises au début du suivant, puis seconde demi-impulsion
+    forcePass(nullptr);
+    kick();
+
+    parallelFor(n, threads, [&](size_t begin, size_t end, int) {
+        for (size_t k = begin; k < end; ++k) {
+            planets[k].rotate(dt);
+            planets[k].appendTrajectory();
+        }
+    });
+    pairCount = pairs.size();
+    groupCount = members.size();
+    return dt;
+}
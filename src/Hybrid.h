@@ -0,0 +1,58 @@
+// Hybrid.h
+#ifndef HYBRID_H
+#define HYBRID_H
+
+#include <cstddef>
+#include <map>
+#include <vector>
+#include "Ias15.h"
+#include "Options.h"
+#include "Planet.h"
+
+const double HYBRID_DEFAULT_HILL_FACTOR = 3.0; // Rayon de rencontre par défaut, en rayons de Hill
+
+// Intégrateur hybride à bascule par paires (dans l'esprit de MERCURY et TRACE). Le hamiltonien est
+// découpé en interactions lointaines et proches : une paire est proche si les deux corps passent
+// pendant le pas à moins de hillFactor rayons de Hill du plus gros des deux (rayon de Hill par
+// rapport au corps le plus massif, le Soleil ; rayon physique au minimum). Chaque pas est un
+// saute-mouton : demi-impulsion des forces lointaines, dérive, demi-impulsion. Les corps sans
+// rencontre dérivent en ligne droite ; ceux d'une rencontre sont regroupés (paires reliées) et chaque
+// groupe dérive sous ses seules interactions proches avec IAS15, jusqu'à la fin exacte du pas.
+// Une rencontre coûte donc quelques évaluations de paires, jamais un petit pas pour tout le système.
+// Les forces lointaines sont le total de la passe de forces habituelle (addForceTasks) moins les
+// paires proches, et le total de fin de pas sert au début du suivant : une passe par pas.
+// Les rencontres sont cherchées au début du pas par balayage et élagage (comme les collisions) sur
+// le mouvement en ligne droite du pas, puis gardées jusqu'à sa fin. La bascule est franche : le
+// schéma n'est plus exactement symplectique au pas où une paire entre ou sort de rencontre.
+class HybridIntegrator {
+public:
+    // epsilon et minimum : tolérance et plus petit pas d'IAS15 dans les rencontres
+    HybridIntegrator(double hillFactor, double epsilon, double minimum);
+
+    // Pas de durée options.dt : forces par addForceTasks (méthode, threads et mode de options),
+    // rotation et trajectoires comme Planet::update. potential, si non nul, reçoit l'énergie
+    // potentielle au début du pas (une passe de forces de plus). Retourne la durée du pas.
+    double step(std::vector<Planet>& planets, const SimulationOptions& options, double* potential = nullptr);
+
+    // Rencontres du dernier pas
+    size_t closePairs() const;
+    size_t groups() const;
+
+    // Corps fusionnés ou réordonnés : oublie les accélérations de fin de pas et les groupes
+    void reset();
+
+private:
+    struct ClosePair {
+        size_t i, j;
+    };
+
+    void findClosePairs(const std::vector<Planet>& planets, double dt, std::vector<ClosePair>& pairs) const;
+
+    double hillFactor, epsilon, minimum;
+    std::vector<double> total;   // Accélérations de toutes les paires à la fin du dernier pas
+    bool totalValid;
+    size_t pairCount, groupCount;
+    std::map<std::vector<unsigned int>, Ias15Integrator> groupIntegrators; // Par identifiants des membres
+};
+
+#endif // HYBRID_H
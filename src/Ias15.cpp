@@ -0,0 +1,359 @@
+// Ias15.cpp
+#include "Ias15.h"
+#include "Parallel.h"
+#include "Physics.h"
+#include "Scheduler.h"
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+// Nœuds de Gauss-Radau sur [0, 1], le premier compris
+static const double H[8] = {
+    0.0, 0.0562625605369221464656521910, 0.1802406917368923649875799428, 0.3526247171131696373739077702,
+    0.5471536263305553830014485577, 0.7342101772154105315232106083, 0.8853209468390957680903597629,
+    0.9775206135612875018911745004
+};
+
+// Écarts entre nœuds : R[j (j - 1) / 2 + k] = H[j] - H[k], pour j = 1 à 7 et k < j
+static const double R[28] = {
+    0.0562625605369221464656522, 0.1802406917368923649875799, 0.1239781311999702185219278,
+    0.3526247171131696373739078, 0.2963621565762474909082556, 0.1723840253762772723863278,
+    0.5471536263305553830014486, 0.4908910657936332365357964, 0.3669129345936630180138686,
+    0.1945289092173857456275408, 0.7342101772154105315232106, 0.6779476166784883850575584,
+    0.5539694854785181665356307, 0.3815854601022408941493028, 0.1870565508848551485217621,
+    0.8853209468390957680903598, 0.8290583863021736216247076, 0.7050802551022034031027798,
+    0.5326962297259261307164520, 0.3381673205085403850889112, 0.1511107696236852365671492,
+    0.9775206135612875018911745, 0.9212580530243653554255223, 0.7972799218243951369035946,
+    0.6248958964481178645172667, 0.4303669872307321188897259, 0.2433104363458769703679639,
+    0.0921996667221917338008147
+};
+
+// Passage des différences divisées g aux coefficients b (C) et retour (D), triangulaires
+static const double C[21] = {
+    -0.0562625605369221464656522, 0.0101408028300636299864818, -0.2365032522738145114532321,
+    -0.0035758977292516175949345, 0.0935376952594620658957485, -0.5891279693869841488271399,
+    0.0019565654099472210769006, -0.0547553868890686864408084, 0.4158812000823068616886219,
+    -1.1362815957175395318285885, -0.0014365302363708915424460, 0.0421585277212687077072973,
+    -0.3600995965020568122897665, 1.2501507118406910258505441, -1.8704917729329500633517991,
+    0.0012717903090268677492943, -0.0387603579159067703699046, 0.3609622434528459832253398,
+    -1.4668842084004269643701553, 2.9061362593084293014237913, -2.7558127197720458314421588
+};
+static const double D[21] = {
+    0.0562625605369221464656522, 0.0031654757181708292499905, 0.2365032522738145114532321,
+    0.0001780977692217433881125, 0.0457929855060279188954539, 0.5891279693869841488271399,
+    0.0000100202365223291272096, 0.0084318571535257015445000, 0.2535340690545692665214616,
+    1.1362815957175395318285885, 0.0000005637641639318207610, 0.0015297840025004658189490,
+    0.0978342365324440053653648, 0.8752546646840910912297246, 1.8704917729329500633517991,
+    0.0000000317188154017613665, 0.0002762930909826476593130, 0.0360285539837364596003871,
+    0.5767330002770787313544596, 2.2485887607691597933926895, 2.7558127197720458314421588
+};
+
+// Somme compensée : value - compensation suit la somme exacte des termes ajoutés
+static inline void addCompensated(double& value, double& compensation, double term) {
+    double y = term - compensation;
+    double t = value + y;
+    compensation = (t - value) - y;
+    value = t;
+}
+
+Ias15Integrator::Ias15Integrator(double epsilon, double initial, double minimum, double maximum)
+    : epsilon(epsilon), minimum(minimum), maximum(maximum), current(std::min(maximum, std::max(minimum, initial))),
+      lastDone(0.0), warned(false) {
+}
+
+double Ias15Integrator::step() const {
+    return current;
+}
+
+void Ias15Integrator::reset() {
+    for (int k = 0; k < 7; ++k) {
+        std::fill(b[k].begin(), b[k].end(), 0.0);
+        std::fill(e[k].begin(), e[k].end(), 0.0);
+    }
+    std::fill(compensationX.begin(), compensationX.end(), 0.0);
+    std::fill(compensationV.begin(), compensationV.end(), 0.0);
+    lastDone = 0.0;
+}
+
+void Ias15Integrator::predict(double ratio) {
+    size_t n3 = b[0].size();
+    if (ratio > 20.0) {
+        // Pas beaucoup plus long : l'extrapolation ne vaut plus rien
+        for (int k = 0; k < 7; ++k) {
+            std::fill(b[k].begin(), b[k].end(), 0.0);
+            std::fill(e[k].begin(), e[k].end(), 0.0);
+        }
+        return;
+    }
+    double q1 = ratio, q2 = q1 * q1, q3 = q1 * q2, q4 = q2 * q2, q5 = q2 * q3, q6 = q3 * q3, q7 = q3 * q4;
+    for (size_t i = 0; i < n3; ++i) {
+        const double p0 = lastB[0][i], p1 = lastB[1][i], p2 = lastB[2][i], p3 = lastB[3][i];
+        const double p4 = lastB[4][i], p5 = lastB[5][i], p6 = lastB[6][i];
+        // Écart entre les coefficients convergés et leur prédiction, reporté sur la nouvelle
+        double correction[7];
+        for (int k = 0; k < 7; ++k) {
+            correction[k] = lastB[k][i] - lastE[k][i];
+        }
+        e[0][i] = q1 * (p6 * 7.0 + p5 * 6.0 + p4 * 5.0 + p3 * 4.0 + p2 * 3.0 + p1 * 2.0 + p0);
+        e[1][i] = q2 * (p6 * 21.0 + p5 * 15.0 + p4 * 10.0 + p3 * 6.0 + p2 * 3.0 + p1);
+        e[2][i] = q3 * (p6 * 35.0 + p5 * 20.0 + p4 * 10.0 + p3 * 4.0 + p2);
+        e[3][i] = q4 * (p6 * 35.0 + p5 * 15.0 + p4 * 5.0 + p3);
+        e[4][i] = q5 * (p6 * 21.0 + p5 * 6.0 + p4);
+        e[5][i] = q6 * (p6 * 7.0 + p5);
+        e[6][i] = q7 * p6;
+        for (int k = 0; k < 7; ++k) {
+            b[k][i] = e[k][i] + correction[k];
+        }
+    }
+}
+
+double Ias15Integrator::integrate(std::vector<double>& position, std::vector<double>& velocity,
+                                  const AccelerationFunction& accelerations, double limit) {
+    const size_t n3 = position.size();
+    if (x0.size() != n3) {
+        for (int k = 0; k < 7; ++k) {
+            b[k].assign(n3, 0.0);
+            e[k].assign(n3, 0.0);
+            g[k].assign(n3, 0.0);
+            lastB[k].assign(n3, 0.0);
+            lastE[k].assign(n3, 0.0);
+        }
+        x0.resize(n3);
+        v0.resize(n3);
+        a0.resize(n3);
+        substep.resize(n3);
+        at.resize(n3);
+        compensationX.assign(n3, 0.0);
+        compensationV.assign(n3, 0.0);
+        lastDone = 0.0;
+    }
+    x0 = position;
+    v0 = velocity;
+    accelerations(x0.data(), a0.data());
+
+    for (;;) {
+        const bool clamped = limit > 0.0 && limit < current;
+        const double dt = clamped ? limit : current;
+        for (size_t i = 0; i < n3; ++i) {
+            g[0][i] = b[6][i] * D[15] + b[5][i] * D[10] + b[4][i] * D[6] + b[3][i] * D[3] + b[2][i] * D[1] + b[1][i] * D[0] + b[0][i];
+            g[1][i] = b[6][i] * D[16] + b[5][i] * D[11] + b[4][i] * D[7] + b[3][i] * D[4] + b[2][i] * D[2] + b[1][i];
+            g[2][i] = b[6][i] * D[17] + b[5][i] * D[12] + b[4][i] * D[8] + b[3][i] * D[5] + b[2][i];
+            g[3][i] = b[6][i] * D[18] + b[5][i] * D[13] + b[4][i] * D[9] + b[3][i];
+            g[4][i] = b[6][i] * D[19] + b[5][i] * D[14] + b[4][i];
+            g[5][i] = b[6][i] * D[20] + b[5][i];
+            g[6][i] = b[6][i];
+        }
+
+        // Prédicteur-correcteur : s'arrête quand la correction de b6 passe sous la précision
+        // machine, ou quand elle cesse de diminuer
+        double correction = 1e300, previousCorrection = 2.0;
+        for (int iteration = 0;; ++iteration) {
+            if (correction < 1e-16) {
+                break;
+            }
+            if (iteration > 2 && previousCorrection <= correction) {
+                break;
+            }
+            if (iteration >= IAS15_MAX_ITERATIONS) {
+                if (!warned) {
+                    std::cerr << "Warning: IAS15 predictor-corrector did not converge (discontinuous forces?)"
+                              << std::endl;
+                    warned = true;
+                }
+                break;
+            }
+            previousCorrection = correction;
+            double maxAcceleration = 0.0, maxChange = 0.0;
+            for (int n = 1; n < 8; ++n) {
+                const double h = H[n];
+                const double s0 = dt * h;
+                const double s1 = s0 * s0 / 2.0;
+                const double s2 = s1 * h / 3.0;
+                const double s3 = s2 * h / 2.0;
+                const double s4 = 3.0 * s3 * h / 5.0;
+                const double s5 = 2.0 * s4 * h / 3.0;
+                const double s6 = 5.0 * s5 * h / 7.0;
+                const double s7 = 3.0 * s6 * h / 4.0;
+                const double s8 = 7.0 * s7 * h / 9.0;
+                for (size_t i = 0; i < n3; ++i) {
+                    substep[i] = -compensationX[i] + ((s8 * b[6][i] + s7 * b[5][i] + s6 * b[4][i] + s5 * b[3][i] +
+                                                       s4 * b[2][i] + s3 * b[1][i] + s2 * b[0][i] + s1 * a0[i] +
+                                                       s0 * v0[i]) + x0[i]);
+                }
+                accelerations(substep.data(), at.data());
+
+                // Nouvelle différence divisée du nœud n, répercutée sur les coefficients b
+                for (size_t i = 0; i < n3; ++i) {
+                    const double gk = at[i] - a0[i];
+                    double previous = g[n - 1][i];
+                    switch (n) {
+                    case 1:
+                        g[0][i] = gk / R[0];
+                        break;
+                    case 2:
+                        g[1][i] = (gk / R[1] - g[0][i]) / R[2];
+                        break;
+                    case 3:
+                        g[2][i] = ((gk / R[3] - g[0][i]) / R[4] - g[1][i]) / R[5];
+                        break;
+                    case 4:
+                        g[3][i] = (((gk / R[6] - g[0][i]) / R[7] - g[1][i]) / R[8] - g[2][i]) / R[9];
+                        break;
+                    case 5:
+                        g[4][i] = ((((gk / R[10] - g[0][i]) / R[11] - g[1][i]) / R[12] - g[2][i]) / R[13] - g[3][i]) / R[14];
+                        break;
+                    case 6:
+                        g[5][i] = (((((gk / R[15] - g[0][i]) / R[16] - g[1][i]) / R[17] - g[2][i]) / R[18] - g[3][i]) /
+                                   R[19] - g[4][i]) / R[20];
+                        break;
+                    default:
+                        g[6][i] = ((((((gk / R[21] - g[0][i]) / R[22] - g[1][i]) / R[23] - g[2][i]) / R[24] - g[3][i]) /
+                                    R[25] - g[4][i]) / R[26] - g[5][i]) / R[27];
+                        break;
+                    }
+                    const double change = g[n - 1][i] - previous;
+                    // C[(n - 1)(n - 2) / 2 + k] : poids de g[n - 1] dans b[k]
+                    const double* weights = &C[(n - 1) * (n - 2) / 2];
+                    for (int k = 0; k < n - 1; ++k) {
+                        b[k][i] += change * weights[k];
+                    }
+                    b[n - 1][i] += change;
+                    if (n == 7) {
+                        maxAcceleration = std::max(maxAcceleration, fabs(at[i]));
+                        maxChange = std::max(maxChange, fabs(change));
+                    }
+                }
+            }
+            correction = maxAcceleration > 0.0 ? maxChange / maxAcceleration : 0.0;
+        }
+
+        // Erreur du pas : dernier coefficient rapporté à l'accélération, sur les corps dont la
+        // position change assez pendant le pas pour que leur accélération compte
+        double maxAcceleration = 0.0, maxLast = 0.0;
+        for (size_t i = 0; i < n3; i += 3) {
+            double v2 = v0[i] * v0[i] + v0[i + 1] * v0[i + 1] + v0[i + 2] * v0[i + 2];
+            double x2 = x0[i] * x0[i] + x0[i + 1] * x0[i + 1] + x0[i + 2] * x0[i + 2];
+            if (fabs(v2 * dt * dt / x2) < 1e-16) {
+                continue;
+            }
+            for (int c = 0; c < 3; ++c) {
+                double a = fabs(at[i + c]);
+                if (std::isnormal(a) && a > maxAcceleration) {
+                    maxAcceleration = a;
+                }
+                double last = fabs(b[6][i + c]);
+                if (std::isnormal(last) && last > maxLast) {
+                    maxLast = last;
+                }
+            }
+        }
+        double error = maxLast / maxAcceleration;
+        double next = std::isnormal(error) ? pow(epsilon / error, 1.0 / 7.0) * dt : dt / IAS15_SAFETY;
+        next = std::min(maximum, std::max(minimum, next));
+
+        if (next / dt < IAS15_SAFETY) {
+            // Pas trop long : recommencer avec le pas proposé, coefficients prédits à nouveau
+            current = next;
+            if (lastDone != 0.0) {
+                predict(current / lastDone);
+            }
+            continue;
+        }
+        // Un pas raccourci par limit ne freine pas la croissance des suivants
+        current = std::min(next, (clamped ? current : dt) / IAS15_SAFETY);
+
+        // Fin du pas, termes du plus petit au plus grand
+        const double dt2 = dt * dt;
+        for (size_t i = 0; i < n3; ++i) {
+            double& x = x0[i];
+            double& cx = compensationX[i];
+            addCompensated(x, cx, b[6][i] / 72.0 * dt2);
+            addCompensated(x, cx, b[5][i] / 56.0 * dt2);
+            addCompensated(x, cx, b[4][i] / 42.0 * dt2);
+            addCompensated(x, cx, b[3][i] / 30.0 * dt2);
+            addCompensated(x, cx, b[2][i] / 20.0 * dt2);
+            addCompensated(x, cx, b[1][i] / 12.0 * dt2);
+            addCompensated(x, cx, b[0][i] / 6.0 * dt2);
+            addCompensated(x, cx, a0[i] / 2.0 * dt2);
+            addCompensated(x, cx, v0[i] * dt);
+            double& v = v0[i];
+            double& cv = compensationV[i];
+            addCompensated(v, cv, b[6][i] / 8.0 * dt);
+            addCompensated(v, cv, b[5][i] / 7.0 * dt);
+            addCompensated(v, cv, b[4][i] / 6.0 * dt);
+            addCompensated(v, cv, b[3][i] / 5.0 * dt);
+            addCompensated(v, cv, b[2][i] / 4.0 * dt);
+            addCompensated(v, cv, b[1][i] / 3.0 * dt);
+            addCompensated(v, cv, b[0][i] / 2.0 * dt);
+            addCompensated(v, cv, a0[i] * dt);
+        }
+        position = x0;
+        velocity = v0;
+
+        lastDone = dt;
+        for (int k = 0; k < 7; ++k) {
+            lastB[k] = b[k];
+            lastE[k] = e[k];
+        }
+        predict(current / dt);
+        return dt;
+    }
+}
+
+double stepIas15(Ias15Integrator& integrator, std::vector<Planet>& planets, const SimulationOptions& options,
+                 double* potential) {
+    const size_t n = planets.size();
+    const int threads = resolveThreadCount(options.threads);
+    std::vector<double> position(n * 3), velocity(n * 3);
+    for (size_t k = 0; k < n; ++k) {
+        const Planet& p = planets[k];
+        position[k * 3] = p.x;
+        position[k * 3 + 1] = p.y;
+        position[k * 3 + 2] = p.z;
+        velocity[k * 3] = p.vx;
+        velocity[k * 3 + 1] = p.vy;
+        velocity[k * 3 + 2] = p.vz;
+    }
+
+    // Chaque évaluation place les corps aux positions demandées et relit leurs accélérations ;
+    // la première (début du pas) fournit aussi l'énergie potentielle
+    TaskGraph graph;
+    double* pendingPotential = potential;
+    AccelerationFunction accelerations = [&](const double* x, double* a) {
+        parallelFor(n, threads, [&planets, x](size_t begin, size_t end, int) {
+            for (size_t k = begin; k < end; ++k) {
+                planets[k].x = x[k * 3];
+                planets[k].y = x[k * 3 + 1];
+                planets[k].z = x[k * 3 + 2];
+                planets[k].ax = planets[k].ay = planets[k].az = 0.0;
+            }
+        });
+        graph.clear();
+        addForceTasks(graph, planets, options.forceMethod, options.theta, options.threads, options.deterministic,
+                      pendingPotential);
+        graph.run(threads);
+        pendingPotential = nullptr;
+        for (size_t k = 0; k < n; ++k) {
+            a[k * 3] = planets[k].ax;
+            a[k * 3 + 1] = planets[k].ay;
+            a[k * 3 + 2] = planets[k].az;
+        }
+    };
+    double dt = integrator.integrate(position, velocity, accelerations);
+
+    parallelFor(n, threads, [&](size_t begin, size_t end, int) {
+        for (size_t k = begin; k < end; ++k) {
+            Planet& p = planets[k];
+            p.x = position[k * 3];
+            p.y = position[k * 3 + 1];
+            p.z = position[k * 3 + 2];
+            p.vx = velocity[k * 3];
+            p.vy = velocity[k * 3 + 1];
+            p.vz = velocity[k * 3 + 2];
+            p.ax = p.ay = p.az = 0.0;
+            p.rotate(dt);
+            p.appendTrajectory();
+        }
+    });
+    return dt;
+}
@@ -0,0 +1,64 @@
+// Ias15.h
+#ifndef IAS15_H
+#define IAS15_H
+
+#include <functional>
+#include <vector>
+#include "Planet.h"
+#include "Options.h"
+
+const double IAS15_DEFAULT_EPSILON = 1e-9; // Tolérance par défaut de l'erreur relative d'un pas
+const double IAS15_SAFETY = 0.25;          // Pas rejeté s'il faudrait le réduire au-delà de ce facteur, et
+                                           // jamais augmenté de plus de son inverse
+const int IAS15_MAX_ITERATIONS = 12;       // Itérations du prédicteur-correcteur par pas
+
+// Accélérations (ax, ay, az par corps) aux positions (x, y, z par corps)
+typedef std::function<void(const double* position, double* acceleration)> AccelerationFunction;
+
+// Intégrateur de Gauss-Radau d'ordre 15 à pas adaptatif (IAS15, Rein et Spiegel 2015).
+// Sur chaque pas, l'accélération est développée en polynôme de degré 7 du temps ; ses coefficients
+// sont obtenus par un prédicteur-correcteur aux 7 nœuds de Radau, itéré jusqu'à ce que la correction
+// du dernier tombe sous la précision machine. Le dernier coefficient rapporté à l'accélération
+// mesure l'erreur du pas, d'où le pas suivant (epsilon / erreur)^(1/7) fois le pas fait ; un pas qui
+// devrait être réduit de plus de IAS15_SAFETY est recommencé. Les sommes des positions et vitesses
+// sont compensées (Kahan) : l'arrondi ne s'accumule pas d'un pas à l'autre. Les coefficients du pas
+// suivant sont prédits à partir de ceux du pas fait, d'où une ou deux itérations par pas en régime établi.
+class Ias15Integrator {
+public:
+    // initial : premier pas essayé ; minimum et maximum bornent les pas (en secondes)
+    Ias15Integrator(double epsilon, double initial, double minimum, double maximum);
+
+    // Un pas accepté (après d'éventuels rejets) ; retourne sa durée. position et velocity : 3 valeurs
+    // par corps. Entre deux appels, les corps ne doivent pas changer sans appel à reset, sauf par
+    // de petites impulsions sur les vitesses (les prédictions ne sont que des points de départ).
+    // limit, si positif, borne ce pas pour finir exactement à un instant donné, sans réduire les
+    // pas suivants.
+    double integrate(std::vector<double>& position, std::vector<double>& velocity,
+                     const AccelerationFunction& accelerations, double limit = 0.0);
+
+    double step() const; // Prochain pas essayé
+
+    // Corps modifiés de l'extérieur (fusion, rangement) : oublie les coefficients prédits et les
+    // termes de compensation, sans changer le prochain pas
+    void reset();
+
+private:
+    void predict(double ratio); // Coefficients du prochain pas à partir de ceux du dernier pas fait
+
+    double epsilon, minimum, maximum;
+    double current;  // Prochain pas essayé
+    double lastDone; // Dernier pas accepté (0 : aucun depuis reset)
+    bool warned;
+    std::vector<double> b[7], e[7], g[7]; // Coefficients du pas, prédictions, différences divisées
+    std::vector<double> lastB[7], lastE[7]; // Valeurs du dernier pas fait, pour prédire après un rejet
+    std::vector<double> x0, v0, a0, substep, at;
+    std::vector<double> compensationX, compensationV;
+};
+
+// Pas IAS15 de tout le système, le pas choisi par l'intégrateur : forces de addForceTasks (méthode,
+// threads et mode de options), puis rotation et trajectoires comme Planet::update. potential, si
+// non nul, reçoit l'énergie potentielle au début du pas. Retourne la durée du pas.
+double stepIas15(Ias15Integrator& integrator, std::vector<Planet>& planets, const SimulationOptions& options,
+                 double* potential = nullptr);
+
+#endif // IAS15_H
@@ -0,0 +1,73 @@
+// Lod.cpp
+#include "Lod.h"
+#include <GL/glew.h>
+#include <OpenGL/glu.h>
+#include <cmath>
+#include <limits>
+
+static const int sphereSubdivisions[LOD_POINT] = { 32, 16, 8 };
+static const int ringSubdivisions[LOD_POINT] = { 100, 48, 16 };
+
+RenderView makeRenderView(double eyeX, double eyeY, double eyeZ, const double projection[16], const double modelview[16],
+                          int viewportHeight) {
+    RenderView view;
+    view.eyeX = eyeX;
+    view.eyeY = eyeY;
+    view.eyeZ = eyeZ;
+
+    // projection[5] = 1 / tan(fovy / 2) : une tangente de 1 couvre la demi-hauteur multipliée par ce facteur
+    view.pixelScale = projection[5] * viewportHeight * 0.5;
+    view.frustum.extract(projection, modelview);
+    view.occluders = nullptr;
+    return view;
+}
+
+RenderView captureRenderView(double eyeX, double eyeY, double eyeZ) {
+    GLdouble projection[16], modelview[16];
+    GLint viewport[4];
+    glGetDoublev(GL_PROJECTION_MATRIX, projection);
+    glGetDoublev(GL_MODELVIEW_MATRIX, modelview);
+    glGetIntegerv(GL_VIEWPORT, viewport);
+    return makeRenderView(eyeX, eyeY, eyeZ, projection, modelview, viewport[3]);
+}
+
+double projectedRadius(const RenderView& view, double x, double y, double z, double radius) {
+    double dx = x - view.eyeX;
+    double dy = y - view.eyeY;
+    double dz = z - view.eyeZ;
+    double d2 = dx*dx + dy*dy + dz*dz;
+    double r2 = radius * radius;
+    if (d2 <= r2) {
+        return std::numeric_limits<double>::infinity(); // Caméra à l'intérieur de la sphère
+    }
+    return radius / sqrt(d2 - r2) * view.pixelScale;
+}
+
+LodLevel selectLod(double pixelRadius) {
+    if (pixelRadius >= LOD_FULL_PIXELS) return LOD_FULL;
+    if (pixelRadius >= LOD_MEDIUM_PIXELS) return LOD_MEDIUM;
+    if (pixelRadius >= LOD_POINT_PIXELS) return LOD_LOW;
+    return LOD_POINT;
+}
+
+void drawSphereMesh(LodLevel level) {
+    static GLuint lists = 0;
+    if (!lists) {
+        lists = glGenLists(LOD_POINT);
+        GLUquadric* quad = gluNewQuadric();
+        gluQuadricTexture(quad, GL_TRUE); // Activer le texturage
+        for (int l = 0; l < LOD_POINT; ++l) {
+            glNewList(lists + l, GL_COMPILE);
+            gluSphere(quad, 1.0, sphereSubdivisions[l], sphereSubdivisions[l]);
+            glEndList();
+        }
+        gluDeleteQuadric(quad);
+    }
+    if (level < LOD_POINT) {
+        glCallList(lists + level);
+    }
+}
+
+int ringSegments(LodLevel level) {
+    return level < LOD_POINT ? ringSubdivisions[level] : 0;
+}
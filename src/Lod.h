@@ -0,0 +1,45 @@
+// Lod.h
+#ifndef LOD_H
+#define LOD_H
+
+#include "Frustum.h"
+
+// Niveaux de détail, choisis selon le rayon apparent à l'écran
+enum LodLevel {
+    LOD_FULL,   // Sphère 32 x 32
+    LOD_MEDIUM, // Sphère 16 x 16
+    LOD_LOW,    // Sphère 8 x 8
+    LOD_POINT,  // Simple point
+    LOD_COUNT
+};
+
+const double LOD_FULL_PIXELS = 48.0;   // Rayon apparent (en pixels) à partir duquel la sphère est complète
+const double LOD_MEDIUM_PIXELS = 12.0; // À partir duquel la sphère intermédiaire est utilisée
+const double LOD_POINT_PIXELS = 1.5;   // En dessous, le corps est dessiné comme un point
+
+struct OccluderSet;
+
+// Caméra du rendu courant, en unités astronomiques
+struct RenderView {
+    double eyeX, eyeY, eyeZ;
+    double pixelScale; // Pixels par unité de tangente angulaire
+    Frustum frustum;
+    const OccluderSet* occluders; // Masquage par les grands corps (nul : désactivé)
+};
+
+// Construire la vue à partir des matrices de projection et de vue (monde -> caméra)
+RenderView makeRenderView(double eyeX, double eyeY, double eyeZ, const double projection[16], const double modelview[16],
+                          int viewportHeight);
+
+// Lire les matrices et le viewport OpenGL courants (pipeline fixe, à appeler après gluLookAt)
+RenderView captureRenderView(double eyeX, double eyeY, double eyeZ);
+
+// Rayon apparent d'une sphère en pixels
+double projectedRadius(const RenderView& view, double x, double y, double z, double radius);
+LodLevel selectLod(double pixelRadius);
+
+// Sphère unitaire texturée, compilée une seule fois par niveau dans une display list
+void drawSphereMesh(LodLevel level);
+int ringSegments(LodLevel level);
+
+#endif // LOD_H
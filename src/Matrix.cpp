@@ -0,0 +1,81 @@
+// Matrix.cpp
+#include "Matrix.h"
+#include <cmath>
+
+void matrixIdentity(double m[16]) {
+    for (int k = 0; k < 16; ++k) {
+        m[k] = (k % 5 == 0) ? 1.0 : 0.0;
+    }
+}
+
+void matrixMultiply(const double a[16], const double b[16], double out[16]) {
+    double result[16];
+    for (int col = 0; col < 4; ++col) {
+        for (int row = 0; row < 4; ++row) {
+            double sum = 0.0;
+            for (int k = 0; k < 4; ++k) {
+                sum += a[k * 4 + row] * b[col * 4 + k];
+            }
+            result[col * 4 + row] = sum;
+        }
+    }
+    for (int k = 0; k < 16; ++k) {
+        out[k] = result[k];
+    }
+}
+
+void matrixPerspective(double fovyDegrees, double aspect, double zNear, double zFar, double m[16]) {
+    double f = 1.0 / tan(fovyDegrees * M_PI / 360.0);
+    for (int k = 0; k < 16; ++k) {
+        m[k] = 0.0;
+    }
+    m[0] = f / aspect;
+    m[5] = f;
+    m[10] = (zFar + zNear) / (zNear - zFar);
+    m[11] = -1.0;
+    m[14] = 2.0 * zFar * zNear / (zNear - zFar);
+}
+
+void matrixPerspectiveReversed(double fovyDegrees, double aspect, double zNear, double m[16]) {
+    double f = 1.0 / tan(fovyDegrees * M_PI / 360.0);
+    for (int k = 0; k < 16; ++k) {
+        m[k] = 0.0;
+    }
+    m[0] = f / aspect;
+    m[5] = f;
+    m[11] = -1.0;
+    m[14] = zNear; // z_clip = zNear, w_clip = -z : profondeur zNear / distance
+}
+
+void matrixLookAt(double eyeX, double eyeY, double eyeZ, double centerX, double centerY, double centerZ,
+                  double upX, double upY, double upZ, double m[16]) {
+    // Direction de visée f, puis s = f x up et u = s x f
+    double fx = centerX - eyeX, fy = centerY - eyeY, fz = centerZ - eyeZ;
+    double fl = sqrt(fx*fx + fy*fy + fz*fz);
+    fx /= fl; fy /= fl; fz /= fl;
+
+    double sx = fy * upZ - fz * upY;
+    double sy = fz * upX - fx * upZ;
+    double sz = fx * upY - fy * upX;
+    double sl = sqrt(sx*sx + sy*sy + sz*sz);
+    sx /= sl; sy /= sl; sz /= sl;
+
+    double ux = sy * fz - sz * fy;
+    double uy = sz * fx - sx * fz;
+    double uz = sx * fy - sy * fx;
+
+    m[0] = sx;  m[4] = sy;  m[8] = sz;
+    m[1] = ux;  m[5] = uy;  m[9] = uz;
+    m[2] = -fx; m[6] = -fy; m[10] = -fz;
+    m[3] = 0.0; m[7] = 0.0; m[11] = 0.0;
+    m[12] = -(sx * eyeX + sy * eyeY + sz * eyeZ);
+    m[13] = -(ux * eyeX + uy * eyeY + uz * eyeZ);
+    m[14] = fx * eyeX + fy * eyeY + fz * eyeZ;
+    m[15] = 1.0;
+}
+
+void matrixToFloat(const double m[16], float out[16]) {
+    for (int k = 0; k < 16; ++k) {
+        out[k] = static_cast<float>(m[k]);
+    }
+}
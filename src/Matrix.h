@@ -0,0 +1,21 @@
+// Matrix.h
+#ifndef MATRIX_H
+#define MATRIX_H
+
+// Matrices 4 x 4 en double, ordre colonne comme OpenGL : m[colonne * 4 + ligne]
+
+void matrixIdentity(double m[16]);
+void matrixMultiply(const double a[16], const double b[16], double out[16]); // out = a * b
+
+// Équivalents de gluPerspective et gluLookAt
+void matrixPerspective(double fovyDegrees, double aspect, double zNear, double zFar, double m[16]);
+void matrixLookAt(double eyeX, double eyeY, double eyeZ, double centerX, double centerY, double centerZ,
+                  double upX, double upY, double upZ, double m[16]);
+
+// Perspective inversée à plan lointain infini : profondeur 1 au plan proche, 0 à l'infini
+// (pour glClipControl(GL_LOWER_LEFT, GL_ZERO_TO_ONE), voir DepthTarget)
+void matrixPerspectiveReversed(double fovyDegrees, double aspect, double zNear, double m[16]);
+
+void matrixToFloat(const double m[16], float out[16]);
+
+#endif // MATRIX_H
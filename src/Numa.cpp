@@ -0,0 +1,281 @@
+// Numa.cpp
+#include "Numa.h"
+#include "Parallel.h"
+#include "Scheduler.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <thread>
+#include <sys/mman.h>
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+// Liste de CPU au format du noyau, par exemple « 0-3,8-11 »
+static std::vector<int> parseCpuList(const char* text) {
+    std::vector<int> cpus;
+    const char* p = text;
+    while (*p) {
+        char* end;
+        long first = strtol(p, &end, 10);
+        if (end == p) {
+            break;
+        }
+        long last = first;
+        p = end;
+        if (*p == '-') {
+            last = strtol(p + 1, &end, 10);
+            p = end;
+        }
+        for (long cpu = first; cpu <= last; ++cpu) {
+            cpus.push_back(static_cast<int>(cpu));
+        }
+        if (*p == ',') {
+            ++p;
+        } else {
+            break;
+        }
+    }
+    return cpus;
+}
+
+static NumaTopology readTopology() {
+    NumaTopology topology;
+#ifdef __linux__
+    for (int node = 0; node < 1024; ++node) {
+        char path[128];
+        snprintf(path, sizeof(path), "/sys/devices/system/node/node%d/cpulist", node);
+        FILE* file = fopen(path, "r");
+        if (!file) {
+            if (node > 0 && topology.nodes.empty()) {
+                break;
+            }
+            continue; // Les numéros de nœuds peuvent être discontinus
+        }
+        char line[4096] = { 0 };
+        if (fgets(line, sizeof(line), file)) {
+            std::vector<int> cpus = parseCpuList(line);
+            if (!cpus.empty()) {
+                topology.nodes.push_back(cpus);
+            }
+        }
+        fclose(file);
+    }
+#endif
+    if (topology.nodes.empty()) {
+        std::vector<int> cpus(std::max(1u, std::thread::hardware_concurrency()));
+        for (size_t k = 0; k < cpus.size(); ++k) {
+            cpus[k] = static_cast<int>(k);
+        }
+        topology.nodes.push_back(cpus);
+    }
+    return topology;
+}
+
+const NumaTopology& numaTopology() {
+    static NumaTopology topology = readTopology();
+    return topology;
+}
+
+static void threadSlot(int index, int& node, int& cpu) {
+    const NumaTopology& topology = numaTopology();
+    size_t total = 0;
+    for (const auto& cpus : topology.nodes) {
+        total += cpus.size();
+    }
+    size_t slot = static_cast<size_t>(index) % total;
+    for (size_t n = 0; n < topology.nodes.size(); ++n) {
+        if (slot < topology.nodes[n].size()) {
+            node = static_cast<int>(n);
+            cpu = topology.nodes[n][slot];
+            return;
+        }
+        slot -= topology.nodes[n].size();
+    }
+    node = 0;
+    cpu = topology.nodes[0][0];
+}
+
+int numaCpuForThread(int index) {
+    int node, cpu;
+    threadSlot(index, node, cpu);
+    return cpu;
+}
+
+int numaNodeForThread(int index) {
+    int node, cpu;
+    threadSlot(index, node, cpu);
+    return node;
+}
+
+#ifdef __linux__
+// Affinité du thread principal avant toute fixation (les threads créés ensuite en héritent)
+static const cpu_set_t& originalAffinity() {
+    static cpu_set_t original = [] {
+        cpu_set_t set;
+        if (pthread_getaffinity_np(pthread_self(), sizeof(set), &set) != 0) {
+            CPU_ZERO(&set);
+            for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+                CPU_SET(cpu, &set);
+            }
+        }
+        return set;
+    }();
+    return original;
+}
+#endif
+
+bool pinCurrentThread(int cpu) {
+#ifdef __linux__
+    originalAffinity(); // Relevée avant la première fixation
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+#else
+    (void)cpu;
+    return false; // macOS n'expose pas d'affinité stricte
+#endif
+}
+
+bool unpinCurrentThread() {
+#ifdef __linux__
+    const cpu_set_t& set = originalAffinity();
+    return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+#else
+    return false;
+#endif
+}
+
+void* allocateUntouched(size_t bytes) {
+    void* memory = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    return memory == MAP_FAILED ? nullptr : memory;
+}
+
+void releaseUntouched(void* memory, size_t bytes) {
+    if (memory) {
+        munmap(memory, bytes);
+    }
+}
+
+// Tableaux SoA des corps du banc d'essai, dans une seule réservation
+struct BenchmarkBodies {
+    double* x, * y, * z, * vx, * vy, * vz;
+    void* memory;
+    size_t bytes;
+};
+
+static const int BENCHMARK_ARRAYS = 6;
+
+static bool allocateBodies(BenchmarkBodies& bodies, size_t n) {
+    // Chaque tableau commence sur une page : une tranche ne partage de page qu'à ses bords
+    size_t stride = (n * sizeof(double) + 4095) & ~static_cast<size_t>(4095);
+    bodies.bytes = stride * BENCHMARK_ARRAYS;
+    bodies.memory = allocateUntouched(bodies.bytes);
+    if (!bodies.memory) {
+        return false;
+    }
+    double** arrays[BENCHMARK_ARRAYS] = { &bodies.x, &bodies.y, &bodies.z, &bodies.vx, &bodies.vy, &bodies.vz };
+    for (int a = 0; a < BENCHMARK_ARRAYS; ++a) {
+        *arrays[a] = reinterpret_cast<double*>(static_cast<char*>(bodies.memory) + a * stride);
+    }
+    return true;
+}
+
+// Orbites circulaires dans la ceinture ; la valeur ne dépend que de l'indice
+static void initializeBodies(BenchmarkBodies& bodies, size_t begin, size_t end) {
+    for (size_t i = begin; i < end; ++i) {
+        double d = (2.1 + 1.2 * ((i * 2654435761u) % 1000003) / 1000003.0) * AU;
+        double theta = 2.0 * M_PI * ((i * 40503u) % 65536) / 65536.0;
+        double speed = sqrt(G * 1.989e30 / d);
+        bodies.x[i] = d * cos(theta);
+        bodies.y[i] = d * sin(theta);
+        bodies.z[i] = 0.0;
+        bodies.vx[i] = -speed * sin(theta);
+        bodies.vy[i] = speed * cos(theta);
+        bodies.vz[i] = 0.0;
+    }
+}
+
+// Attraction du Soleil puis pas d'Euler semi-implicite : six doubles lus et écrits par corps,
+// la mémoire domine le coût
+static void stepBodies(BenchmarkBodies& bodies, size_t begin, size_t end, double dt) {
+    const double gm = G * 1.989e30;
+    for (size_t i = begin; i < end; ++i) {
+        double x = bodies.x[i], y = bodies.y[i], z = bodies.z[i];
+        double r2 = x*x + y*y + z*z;
+        double factor = -gm / (r2 * sqrt(r2));
+        bodies.vx[i] += factor * x * dt;
+        bodies.vy[i] += factor * y * dt;
+        bodies.vz[i] += factor * z * dt;
+        bodies.x[i] = x + bodies.vx[i] * dt;
+        bodies.y[i] = y + bodies.vy[i] * dt;
+        bodies.z[i] = z + bodies.vz[i] * dt;
+    }
+}
+
+static double runPlacement(size_t n, int threads, int steps, double dt, bool aware, double& checksum) {
+    BenchmarkBodies bodies;
+    if (!allocateBodies(bodies, n)) {
+        std::cerr << "Failed to allocate benchmark bodies" << std::endl;
+        return -1.0;
+    }
+    if (aware) {
+        // Chaque tranche est touchée par le thread qui l'intégrera
+        parallelFor(n, threads, [&bodies](size_t begin, size_t end, int) { initializeBodies(bodies, begin, end); });
+    } else {
+        initializeBodies(bodies, 0, n);
+    }
+
+    double best = 0.0;
+    for (int s = 0; s < steps; ++s) {
+        std::chrono::steady_clock::time_point begin = std::chrono::steady_clock::now();
+        parallelFor(n, threads, [&bodies, dt](size_t first, size_t last, int) { stepBodies(bodies, first, last, dt); });
+        double elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - begin).count();
+        if (s == 0 || elapsed < best) {
+            best = elapsed;
+        }
+    }
+    checksum = 0.0;
+    for (size_t i = 0; i < n; ++i) {
+        checksum += bodies.x[i] + bodies.y[i];
+    }
+    releaseUntouched(bodies.memory, bodies.bytes);
+    return best;
+}
+
+int runNumaBenchmark(const SimulationOptions& options) {
+    size_t n = options.debrisCount > 0 ? static_cast<size_t>(options.debrisCount) : 1000000;
+    int threads = resolveThreadCount(options.threads);
+    const int steps = 20;
+    const NumaTopology& topology = numaTopology();
+
+    std::cout << "NUMA topology: " << topology.nodes.size() << " node(s):";
+    for (const auto& cpus : topology.nodes) {
+        std::cout << " " << cpus.size();
+    }
+    std::cout << " CPU(s)" << std::endl;
+
+    // Placement naïf d'abord, threads libres (y compris le thread principal) ; puis fixés
+    double naiveChecksum = 0.0, awareChecksum = 0.0;
+    schedulerPinThreads(false);
+    double naive = runPlacement(n, threads, steps, options.dt, false, naiveChecksum);
+    schedulerPinThreads(true);
+    double aware = runPlacement(n, threads, steps, options.dt, true, awareChecksum);
+    if (naive < 0.0 || aware < 0.0) {
+        return -1;
+    }
+
+    double bytes = static_cast<double>(n) * BENCHMARK_ARRAYS * sizeof(double) * 2.0; // Lus puis écrits
+    std::cout << "Force and integration loop: " << n << " bodies, " << threads << " thread(s), best of " << steps
+              << " steps" << std::endl;
+    std::cout << "  naive placement:      " << naive << " ms (" << bytes / naive / 1e6 << " GB/s)" << std::endl;
+    std::cout << "  NUMA-aware placement: " << aware << " ms (" << bytes / aware / 1e6 << " GB/s)" << std::endl;
+    std::cout << "  speedup: " << naive / aware << "x, results " << (naiveChecksum == awareChecksum ? "identical" : "differ")
+              << std::endl;
+    return naiveChecksum == awareChecksum ? 0 : 1;
+}
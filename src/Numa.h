@@ -0,0 +1,39 @@
+// Numa.h
+#ifndef NUMA_H
+#define NUMA_H
+
+#include <cstddef>
+#include <vector>
+#include "Options.h"
+
+// CPU de chaque nœud NUMA. Linux : lu dans /sys/devices/system/node ; ailleurs (ou si la
+// lecture échoue), un seul nœud avec tous les cœurs.
+struct NumaTopology {
+    std::vector<std::vector<int>> nodes;
+};
+
+const NumaTopology& numaTopology();
+
+// Threads répartis nœud par nœud : les indices consécutifs remplissent d'abord les CPU du
+// nœud 0, puis ceux du nœud 1, etc. Des tranches contiguës de parallelFor tombent ainsi
+// sur un même nœud, ce qui partitionne les corps par nœud.
+int numaCpuForThread(int index);
+int numaNodeForThread(int index);
+
+// Fixe le thread appelant sur un CPU ; false si la plateforme ne le permet pas
+bool pinCurrentThread(int cpu);
+
+// Rend au thread appelant l'affinité qu'avait le thread principal avant la première fixation
+bool unpinCurrentThread();
+
+// Mémoire réservée sans être touchée : chaque page sera placée sur le nœud du premier
+// thread qui l'écrit (politique « first touch » du noyau). Libérer avec releaseUntouched.
+void* allocateUntouched(size_t bytes);
+void releaseUntouched(void* memory, size_t bytes);
+
+// Mode --benchmark-numa : boucle de forces et d'intégration sur --debris corps (1 million
+// par défaut), d'abord avec placement naïf (tout touché par le thread principal, threads
+// libres) puis avec threads fixés et pages touchées par le thread de chaque tranche
+int runNumaBenchmark(const SimulationOptions& options);
+
+#endif // NUMA_H
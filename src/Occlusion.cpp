@@ -0,0 +1,80 @@
+// Occlusion.cpp
+#include "Occlusion.h"
+#include "Lod.h"
+#include "Planet.h"
+#include <algorithm>
+#include <cmath>
+
+OccluderSet::OccluderSet() : count(0) {
+    eye[0] = eye[1] = eye[2] = 0.0;
+}
+
+void OccluderSet::collect(const RenderView& view, const std::vector<Planet>& planets) {
+    count = 0;
+    eye[0] = view.eyeX;
+    eye[1] = view.eyeY;
+    eye[2] = view.eyeZ;
+
+    // Plus grands rayons apparents d'abord (insertion dans une liste courte)
+    double pixels[MAX_OCCLUDERS];
+    const Planet* chosen[MAX_OCCLUDERS];
+    for (const auto& planet : planets) {
+        double cx = planet.x / AU, cy = planet.y / AU, cz = planet.z / AU, r = planet.radius / AU;
+        if (!view.frustum.containsSphere(cx, cy, cz, r)) {
+            continue;
+        }
+        double pixelRadius = projectedRadius(view, cx, cy, cz, r);
+        if (pixelRadius < OCCLUDER_PIXELS || std::isinf(pixelRadius)) {
+            continue; // Trop petit, ou la caméra est dedans
+        }
+        int slot;
+        if (count < MAX_OCCLUDERS) {
+            slot = count++;
+        } else if (pixelRadius > pixels[MAX_OCCLUDERS - 1]) {
+            slot = MAX_OCCLUDERS - 1;
+        } else {
+            continue;
+        }
+        while (slot > 0 && pixels[slot - 1] < pixelRadius) {
+            pixels[slot] = pixels[slot - 1];
+            chosen[slot] = chosen[slot - 1];
+            --slot;
+        }
+        pixels[slot] = pixelRadius;
+        chosen[slot] = &planet;
+    }
+
+    for (int k = 0; k < count; ++k) {
+        const Planet& planet = *chosen[k];
+        double v[3] = { planet.x / AU - eye[0], planet.y / AU - eye[1], planet.z / AU - eye[2] };
+        double d = sqrt(v[0] * v[0] + v[1] * v[1] + v[2] * v[2]);
+        for (int c = 0; c < 3; ++c) {
+            direction[k][c] = v[c] / d;
+        }
+        distance[k] = d;
+        angle[k] = asin(std::min(1.0, OCCLUDER_INSCRIBED * planet.radius / AU / d)) - OCCLUDER_MARGIN_PIXELS / view.pixelScale;
+    }
+}
+
+bool OccluderSet::hides(double x, double y, double z, double radius) const {
+    if (count == 0) {
+        return false;
+    }
+    double v[3] = { x - eye[0], y - eye[1], z - eye[2] };
+    double d = sqrt(v[0] * v[0] + v[1] * v[1] + v[2] * v[2]);
+    if (d <= radius) {
+        return false; // Caméra dans la sphère
+    }
+    double spread = asin(radius / d);
+    for (int k = 0; k < count; ++k) {
+        if (d - radius < distance[k]) {
+            continue; // Pas entièrement derrière le centre du masque (exclut aussi le masque lui-même)
+        }
+        double cosine = (v[0] * direction[k][0] + v[1] * direction[k][1] + v[2] * direction[k][2]) / d;
+        double offset = acos(std::max(-1.0, std::min(1.0, cosine)));
+        if (offset + spread <= angle[k]) {
+            return true;
+        }
+    }
+    return false;
+}
@@ -0,0 +1,36 @@
+// Occlusion.h
+#ifndef OCCLUSION_H
+#define OCCLUSION_H
+
+#include <vector>
+
+class Planet;
+struct RenderView;
+
+const int MAX_OCCLUDERS = 4;          // Grands corps retenus comme masques à chaque image
+const double OCCLUDER_PIXELS = 16.0;  // Rayon apparent minimal (en pixels) d'un masque
+const double OCCLUDER_INSCRIBED = 0.97; // Silhouette facettée d'une sphère 16 x 16 rapportée au rayon
+const double OCCLUDER_MARGIN_PIXELS = 2.0; // Points dessinés plus gros que leur sphère, arrondi du tramage
+
+// Masquage par les grands corps proches : une sphère est cachée si elle est entièrement dans
+// le cône de la silhouette d'un masque vu de la caméra et entièrement plus loin que son centre.
+// Tout rayon vers elle entre alors dans le masque (opaque) avant de l'atteindre : le test est
+// conservateur, il ne cache jamais un pixel qui aurait été visible : le cône est celui de la
+// silhouette facettée, réduit de quelques pixels.
+struct OccluderSet {
+    int count;
+    double eye[3];
+    double direction[MAX_OCCLUDERS][3]; // De la caméra vers le centre du masque, normée
+    double distance[MAX_OCCLUDERS];     // Distance de la caméra au centre
+    double angle[MAX_OCCLUDERS];        // Demi-angle du cône de la silhouette
+
+    OccluderSet();
+
+    // Les MAX_OCCLUDERS plus grands corps à l'écran, dans la pyramide, à au moins OCCLUDER_PIXELS
+    void collect(const RenderView& view, const std::vector<Planet>& planets);
+
+    // Sphère en unités astronomiques
+    bool hides(double x, double y, double z, double radius) const;
+};
+
+#endif // OCCLUSION_H
@@ -0,0 +1,550 @@
+// Options.cpp
+#include "Options.h"
+#include "Hybrid.h"
+#include "Ias15.h"
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+
+SimulationOptions::SimulationOptions()
+    : collisionMode(COLLISION_OFF), restitution(0.5), debrisCount(0), seed(42),
+      threads(1), deterministic(false), numa(false), benchmarkNuma(false), forceMethod(FORCE_DIRECT), theta(0.5),
+      softening(SOFTENING_CLAMP), softeningLength(SOFTENING_DEFAULT_LENGTH), softeningRadius(0.0), hashInterval(0),
+      diagnosticsInterval(0), energyAlert(1e-6), momentumAlert(1e-9),
+      dt(60 * 60 * 24 / 365), // Division entière historique : environ 236 s
+      adaptiveTolerance(0.0), dtMin(1.0), dtMax(86400.0), integrator(INTEGRATOR_EULER),
+      ias15Epsilon(IAS15_DEFAULT_EPSILON), encounterRadius(HYBRID_DEFAULT_HILL_FACTOR),
+      ensembleMembers(0), ensembleSteps(36500), ensemblePerturbation(1e-6), ensembleOutput(nullptr),
+      renderer(RENDERER_CORE), depthMode(DEPTH_STANDARD), benchmarkFrames(0),
+      captureTarget(nullptr), captureWidth(800), captureHeight(600), captureFrames(0), headless(false),
+      windowWidth(800), windowHeight(600), fullscreen(false), frameBudget(0.0), minResolutionScale(0.5), asyncPhysics(false),
+      physicsStepsPerFrame(1), occlusionCulling(false), recordPath(nullptr), recordInterval(1), playbackPath(nullptr),
+      playbackSpeed(1.0),
+      compressOutput(nullptr), chebyshevTolerance(100.0), chebyshevWindow(32.0), chebyshevDegree(13), profile(false),
+      reorderInterval(0), benchmarkOrder(false), nearFieldCutoff(0.01),
+      distributedRanks(0), transport(TRANSPORT_SOCKET), distributedSteps(1000), rebalanceInterval(10),
+      splatTarget(nullptr), splatWidth(1024), splatHeight(1024), splatExtent(4.0), splatFrames(1), splatInterval(100) {
+}
+
+void printUsage(const char* program) {
+    std::cerr << "Usage: " << program << " [options]\n"
+              << "  --collisions off|merge|bounce  Collision response (default: off)\n"
+              << "  --restitution E                Bounce restitution coefficient in [0, 1] (default: 0.5)\n"
+              << "  --debris N                     Add N debris bodies in the asteroid belt\n"
+              << "  --seed S                       Random seed for generated bodies (default: 42)\n"
+              << "  --threads N                    Threads for the simulation step, 0 = all cores (default: 1)\n"
+              << "  --deterministic                Reduce forces in a fixed order, independent of --threads\n"
+              << "  --numa                         Pin worker threads node by node so each slice of the body array\n"
+              << "                                 stays on one NUMA node (Linux)\n"
+              << "  --benchmark-numa               Time a force and integration loop over --debris bodies (default\n"
+              << "                                 1000000) with naive and NUMA-aware placement, then exit\n"
+              << "  --forces direct|barnes-hut     All pairs, or an octree with O(n log n) cost (default: direct)\n"
+              << "  --theta T                      Barnes-Hut opening angle, smaller is more accurate (default: 0.5)\n"
+              << "  --softening clamp|plummer|spline\n"
+              << "                                 Short-range force law: distance clamped to the softening length,\n"
+              << "                                 Plummer, or a cubic spline that is exactly Newtonian beyond 2.8\n"
+              << "                                 lengths (default: clamp)\n"
+              << "  --softening-length METERS      Softening length of every body (default: 1000)\n"
+              << "  --softening-radius F           Use F times a body's radius when larger than the length (default: 0)\n"
+              << "  --hash-interval N              Log a hash of the state every N steps\n"
+              << "  --diagnostics-interval N       Log total energy, momentum and angular momentum drifts every N\n"
+              << "                                 steps (potential energy from the force pass of that step)\n"
+              << "  --energy-alert REL             Warn when the relative energy drift exceeds REL (default: 1e-6)\n"
+              << "  --momentum-alert REL           Warn when the relative momentum or angular momentum drift exceeds\n"
+              << "                                 REL (default: 1e-9)\n"
+              << "  --dt SECONDS                   Time step, initial step with --adaptive-dt (default: 236)\n"
+              << "  --adaptive-dt TOL              Choose each time step of the simulation from an error estimate so\n"
+              << "                                 the relative velocity error per step stays near TOL (e.g. 1e-4)\n"
+              << "  --dt-min SECONDS               Smallest adaptive time step (default: 1)\n"
+              << "  --dt-max SECONDS               Largest adaptive time step (default: 86400)\n"
+              << "  --integrator euler|ias15|hybrid\n"
+              << "                                 Symplectic Euler; 15th-order Gauss-Radau with its own step control\n"
+              << "                                 within --dt-min and --dt-max; or leapfrog at --dt that switches\n"
+              << "                                 pairs in close encounter to IAS15 (default: euler)\n"
+              << "  --ias15-epsilon E              Relative error tolerance of an IAS15 step (default: 1e-9)\n"
+              << "  --encounter-radius F           Hybrid close-encounter distance in Hill radii (default: 3)\n"
+              << "  --ensemble N                   Run N perturbed copies of the solar system without a window\n"
+              << "  --ensemble-steps S             Steps per ensemble member (default: 36500)\n"
+              << "  --ensemble-perturbation P      Relative std deviation of initial perturbations (default: 1e-6)\n"
+              << "  --ensemble-output FILE         Write per-member summaries to FILE (CSV, default: stdout)\n"
+              << "  --renderer core|legacy         OpenGL 3.3 core renderer or fixed-function pipeline (default: core)\n"
+              << "  --depth standard|reverse-z|logarithmic\n"
+              << "                                 Depth buffer mode; reverse-z and logarithmic keep precision from\n"
+              << "                                 a moon's surface out to Neptune in one pass (default: standard)\n"
+              << "  --benchmark-frames N           Time N rendered frames, print statistics and exit\n"
+              << "  --capture TARGET               Render offscreen and stream frames to TARGET: a file of raw\n"
+              << "                                 RGBA frames (top row first), \"|command\" to pipe the same\n"
+              << "                                 stream, or a pattern with %d for a PPM image sequence\n"
+              << "  --capture-size WxH             Size of captured frames (default: 800x600)\n"
+              << "  --capture-frames N             Exit after N captured frames\n"
+              << "  --headless                     Hide the window and skip presentation (use with --capture)\n"
+              << "  --window-size WxH              Initial window size, scaled on high-DPI monitors (default: 800x600)\n"
+              << "  --fullscreen                   Fullscreen on the primary monitor at its current video mode\n"
+              << "  --dynamic-resolution MS        Render below the window resolution and upscale whenever the GPU\n"
+              << "                                 time of a frame exceeds MS milliseconds\n"
+              << "  --min-resolution-scale S       Smallest fraction of the window resolution, in (0, 1] (default: 0.5)\n"
+              << "  --async-physics                Step the simulation on its own thread; each frame draws the\n"
+              << "                                 latest published state without waiting for the step\n"
+              << "  --physics-steps N              With --async-physics, run at most N steps per drawn frame, 0 for\n"
+              << "                                 no limit (default: 1); only states beyond one per frame are dropped\n"
+              << "  --occlusion-culling            Skip bodies hidden behind large nearby bodies\n"
+              << "  --record FILE                  Record positions and velocities to an ephemeris file\n"
+              << "  --record-interval N            Record one sample every N steps (default: 1)\n"
+              << "  --playback FILE                Replay an ephemeris file instead of integrating\n"
+              << "                                 (space: pause, [ ]: speed, R: reverse, left/right: scrub)\n"
+              << "  --playback-speed X             Playback rate as a multiple of --dt per frame (default: 1)\n"
+              << "  --compress-ephemeris OUT       Fit Chebyshev series to the --playback file, write OUT and exit\n"
+              << "                                 (--playback also replays compressed files)\n"
+              << "  --chebyshev-tolerance METERS   Maximum position error of the fit (default: 100)\n"
+              << "  --chebyshev-window DAYS        Initial window length, halved until the fit holds (default: 32)\n"
+              << "  --chebyshev-degree N           Maximum degree of the series (default: 13)\n"
+              << "  --profile                      Print per-frame counters (GL state changes, draw calls) on exit\n"
+              << "  --reorder-interval N           Sort bodies along a Morton curve every N steps for memory locality\n"
+              << "                                 (changes summation order, so results differ in the last bits)\n"
+              << "  --benchmark-order              Time a blocked near-field force pass over --debris bodies in\n"
+              << "                                 creation order and in Morton order, then exit\n"
+              << "  --near-field-cutoff AU         Range of that pass (default: 0.01)\n"
+              << "  --distributed P                Split the solar system and --debris bodies across P local\n"
+              << "                                 processes by spatial domain (Barnes-Hut forces), then exit\n"
+              << "  --transport socket|shm         Channels between those processes (default: socket)\n"
+              << "  --distributed-steps S          Steps of the distributed run (default: 1000)\n"
+              << "  --rebalance-interval N         Recompute domains from the measured load every N steps (default: 10)\n"
+              << "  --splat TARGET                 Render top-down previews on the CPU, without OpenGL, to a PPM\n"
+              << "                                 file or a pattern with %d for a sequence, then exit; uses\n"
+              << "                                 Barnes-Hut forces unless --forces direct is given\n"
+              << "  --splat-size WxH               Size of splat previews (default: 1024x1024)\n"
+              << "  --splat-extent AU              Half-width of the previewed region (default: 4)\n"
+              << "  --splat-frames N               Number of previews (default: 1)\n"
+              << "  --splat-interval N             Steps simulated between previews (default: 100)\n"
+              << "  --help                         Show this message" << std::endl;
+}
+
+int framePatternNumbers(const char* pattern) {
+    int numbers = 0;
+    for (const char* c = pattern; *c; ++c) {
+        if (*c != '%') {
+            continue;
+        }
+        ++c;
+        if (*c == 'd') {
+            ++numbers;
+        } else if (*c != '%') {
+            return -1; // Autre conversion, ou % final
+        }
+    }
+    return numbers;
+}
+
+std::string framePath(const std::string& pattern, long long index) {
+    std::string path;
+    for (size_t k = 0; k < pattern.size(); ++k) {
+        if (pattern[k] == '%' && k + 1 < pattern.size()) {
+            ++k;
+            if (pattern[k] == 'd') {
+                path += std::to_string(index);
+                continue;
+            }
+        }
+        path += pattern[k];
+    }
+    return path;
+}
+
+bool parseOptions(int argc, char** argv, SimulationOptions& options) {
+    bool forcesGiven = false;
+    for (int i = 1; i < argc; ++i) {
+        const char* arg = argv[i];
+        const char* value = i + 1 < argc ? argv[i + 1] : nullptr;
+
+        if (strcmp(arg, "--help") == 0) {
+            printUsage(argv[0]);
+            return false;
+        } else if (strcmp(arg, "--collisions") == 0 && value) {
+            if (strcmp(value, "off") == 0) {
+                options.collisionMode = COLLISION_OFF;
+            } else if (strcmp(value, "merge") == 0) {
+                options.collisionMode = COLLISION_MERGE;
+            } else if (strcmp(value, "bounce") == 0) {
+                options.collisionMode = COLLISION_BOUNCE;
+            } else {
+                std::cerr << "Unknown collision mode: " << value << std::endl;
+                return false;
+            }
+            ++i;
+        } else if (strcmp(arg, "--restitution") == 0 && value) {
+            options.restitution = atof(value);
+            if (options.restitution < 0.0 || options.restitution > 1.0) {
+                std::cerr << "Restitution must be in [0, 1]" << std::endl;
+                return false;
+            }
+            ++i;
+        } else if (strcmp(arg, "--debris") == 0 && value) {
+            options.debrisCount = atoi(value);
+            ++i;
+        } else if (strcmp(arg, "--seed") == 0 && value) {
+            options.seed = static_cast<unsigned int>(strtoul(value, nullptr, 10));
+            ++i;
+        } else if (strcmp(arg, "--threads") == 0 && value) {
+            options.threads = atoi(value);
+            ++i;
+        } else if (strcmp(arg, "--deterministic") == 0) {
+            options.deterministic = true;
+        } else if (strcmp(arg, "--numa") == 0) {
+            options.numa = true;
+        } else if (strcmp(arg, "--benchmark-numa") == 0) {
+            options.benchmarkNuma = true;
+        } else if (strcmp(arg, "--forces") == 0 && value) {
+            if (strcmp(value, "direct") == 0) {
+                options.forceMethod = FORCE_DIRECT;
+            } else if (strcmp(value, "barnes-hut") == 0) {
+                options.forceMethod = FORCE_BARNES_HUT;
+            } else {
+                std::cerr << "Unknown force method: " << value << std::endl;
+                return false;
+            }
+            forcesGiven = true;
+            ++i;
+        } else if (strcmp(arg, "--theta") == 0 && value) {
+            options.theta = atof(value);
+            if (options.theta <= 0.0 || options.theta > 1.5) {
+                std::cerr << "Theta must be in (0, 1.5]" << std::endl;
+                return false;
+            }
+            ++i;
+        } else if (strcmp(arg, "--softening") == 0 && value) {
+            if (strcmp(value, "clamp") == 0) {
+                options.softening = SOFTENING_CLAMP;
+            } else if (strcmp(value, "plummer") == 0) {
+                options.softening = SOFTENING_PLUMMER;
+            } else if (strcmp(value, "spline") == 0) {
+                options.softening = SOFTENING_SPLINE;
+            } else {
+                std::cerr << "Unknown softening kernel: " << value << std::endl;
+                return false;
+            }
+            ++i;
+        } else if (strcmp(arg, "--softening-length") == 0 && value) {
+            options.softeningLength = atof(value);
+            if (options.softeningLength <= 0.0) {
+                std::cerr << "Softening length must be positive" << std::endl;
+                return false;
+            }
+            ++i;
+        } else if (strcmp(arg, "--softening-radius") == 0 && value) {
+            options.softeningRadius = atof(value);
+            if (options.softeningRadius < 0.0) {
+                std::cerr << "Softening radius factor must not be negative" << std::endl;
+                return false;
+            }
+            ++i;
+        } else if (strcmp(arg, "--hash-interval") == 0 && value) {
+            options.hashInterval = atoi(value);
+            ++i;
+        } else if (strcmp(arg, "--diagnostics-interval") == 0 && value) {
+            options.diagnosticsInterval = atoi(value);
+            ++i;
+        } else if (strcmp(arg, "--energy-alert") == 0 && value) {
+            options.energyAlert = atof(value);
+            ++i;
+        } else if (strcmp(arg, "--momentum-alert") == 0 && value) {
+            options.momentumAlert = atof(value);
+            ++i;
+        } else if (strcmp(arg, "--dt") == 0 && value) {
+            options.dt = atof(value);
+            if (options.dt <= 0.0) {
+                std::cerr << "Time step must be positive" << std::endl;
+                return false;
+            }
+            ++i;
+        } else if (strcmp(arg, "--adaptive-dt") == 0 && value) {
+            options.adaptiveTolerance = atof(value);
+            if (options.adaptiveTolerance <= 0.0) {
+                std::cerr << "Adaptive time step tolerance must be positive" << std::endl;
+                return false;
+            }
+            ++i;
+        } else if (strcmp(arg, "--dt-min") == 0 && value) {
+            options.dtMin = atof(value);
+            if (options.dtMin <= 0.0) {
+                std::cerr << "Minimum time step must be positive" << std::endl;
+                return false;
+            }
+            ++i;
+        } else if (strcmp(arg, "--dt-max") == 0 && value) {
+            options.dtMax = atof(value);
+            if (options.dtMax <= 0.0) {
+                std::cerr << "Maximum time step must be positive" << std::endl;
+                return false;
+            }
+            ++i;
+        } else if (strcmp(arg, "--integrator") == 0 && value) {
+            if (strcmp(value, "euler") == 0) {
+                options.integrator = INTEGRATOR_EULER;
+            } else if (strcmp(value, "ias15") == 0) {
+                options.integrator = INTEGRATOR_IAS15;
+            } else if (strcmp(value, "hybrid") == 0) {
+                options.integrator = INTEGRATOR_HYBRID;
+            } else {
+                std::cerr << "Unknown integrator: " << value << std::endl;
+                return false;
+            }
+            ++i;
+        } else if (strcmp(arg, "--ias15-epsilon") == 0 && value) {
+            options.ias15Epsilon = atof(value);
+            if (options.ias15Epsilon <= 0.0) {
+                std::cerr << "IAS15 tolerance must be positive" << std::endl;
+                return false;
+            }
+            ++i;
+        } else if (strcmp(arg, "--encounter-radius") == 0 && value) {
+            options.encounterRadius = atof(value);
+            if (options.encounterRadius <= 0.0) {
+                std::cerr << "Encounter radius must be positive" << std::endl;
+                return false;
+            }
+            ++i;
+        } else if (strcmp(arg, "--ensemble") == 0 && value) {
+            options.ensembleMembers = atoi(value);
+            ++i;
+        } else if (strcmp(arg, "--ensemble-steps") == 0 && value) {
+            options.ensembleSteps = atoll(value);
+            ++i;
+        } else if (strcmp(arg, "--ensemble-perturbation") == 0 && value) {
+            options.ensemblePerturbation = atof(value);
+            ++i;
+        } else if (strcmp(arg, "--ensemble-output") == 0 && value) {
+            options.ensembleOutput = value;
+            ++i;
+        } else if (strcmp(arg, "--renderer") == 0 && value) {
+            if (strcmp(value, "core") == 0) {
+                options.renderer = RENDERER_CORE;
+            } else if (strcmp(value, "legacy") == 0) {
+                options.renderer = RENDERER_LEGACY;
+            } else {
+                std::cerr << "Unknown renderer: " << value << std::endl;
+                return false;
+            }
+            ++i;
+        } else if (strcmp(arg, "--depth") == 0 && value) {
+            if (strcmp(value, "standard") == 0) {
+                options.depthMode = DEPTH_STANDARD;
+            } else if (strcmp(value, "reverse-z") == 0) {
+                options.depthMode = DEPTH_REVERSE_Z;
+            } else if (strcmp(value, "logarithmic") == 0) {
+                options.depthMode = DEPTH_LOGARITHMIC;
+            } else {
+                std::cerr << "Unknown depth mode: " << value << std::endl;
+                return false;
+            }
+            ++i;
+        } else if (strcmp(arg, "--benchmark-frames") == 0 && value) {
+            options.benchmarkFrames = atoi(value);
+            ++i;
+        } else if (strcmp(arg, "--capture") == 0 && value) {
+            options.captureTarget = value;
+            ++i;
+        } else if (strcmp(arg, "--capture-size") == 0 && value) {
+            if (sscanf(value, "%dx%d", &options.captureWidth, &options.captureHeight) != 2 ||
+                options.captureWidth <= 0 || options.captureHeight <= 0) {
+                std::cerr << "Invalid capture size: " << value << std::endl;
+                return false;
+            }
+            ++i;
+        } else if (strcmp(arg, "--capture-frames") == 0 && value) {
+            options.captureFrames = atoll(value);
+            ++i;
+        } else if (strcmp(arg, "--headless") == 0) {
+            options.headless = true;
+        } else if (strcmp(arg, "--window-size") == 0 && value) {
+            if (sscanf(value, "%dx%d", &options.windowWidth, &options.windowHeight) != 2 ||
+                options.windowWidth <= 0 || options.windowHeight <= 0) {
+                std::cerr << "Invalid window size: " << value << std::endl;
+                return false;
+            }
+            ++i;
+        } else if (strcmp(arg, "--fullscreen") == 0) {
+            options.fullscreen = true;
+        } else if (strcmp(arg, "--dynamic-resolution") == 0 && value) {
+            options.frameBudget = atof(value);
+            if (options.frameBudget <= 0.0) {
+                std::cerr << "Invalid frame budget: " << value << std::endl;
+                return false;
+            }
+            ++i;
+        } else if (strcmp(arg, "--min-resolution-scale") == 0 && value) {
+            options.minResolutionScale = atof(value);
+            if (options.minResolutionScale <= 0.0 || options.minResolutionScale > 1.0) {
+                std::cerr << "Minimum resolution scale must be in (0, 1]" << std::endl;
+                return false;
+            }
+            ++i;
+        } else if (strcmp(arg, "--async-physics") == 0) {
+            options.asyncPhysics = true;
+        } else if (strcmp(arg, "--physics-steps") == 0 && value) {
+            options.physicsStepsPerFrame = atoi(value);
+            if (options.physicsStepsPerFrame < 0) {
+                std::cerr << "Invalid physics steps per frame: " << value << std::endl;
+                return false;
+            }
+            ++i;
+        } else if (strcmp(arg, "--occlusion-culling") == 0) {
+            options.occlusionCulling = true;
+        } else if (strcmp(arg, "--record") == 0 && value) {
+            options.recordPath = value;
+            ++i;
+        } else if (strcmp(arg, "--record-interval") == 0 && value) {
+            options.recordInterval = atoi(value);
+            if (options.recordInterval < 1) {
+                std::cerr << "Invalid record interval: " << value << std::endl;
+                return false;
+            }
+            ++i;
+        } else if (strcmp(arg, "--playback") == 0 && value) {
+            options.playbackPath = value;
+            ++i;
+        } else if (strcmp(arg, "--playback-speed") == 0 && value) {
+            options.playbackSpeed = atof(value);
+            ++i;
+        } else if (strcmp(arg, "--compress-ephemeris") == 0 && value) {
+            options.compressOutput = value;
+            ++i;
+        } else if (strcmp(arg, "--chebyshev-tolerance") == 0 && value) {
+            options.chebyshevTolerance = atof(value);
+            ++i;
+        } else if (strcmp(arg, "--chebyshev-window") == 0 && value) {
+            options.chebyshevWindow = atof(value);
+            ++i;
+        } else if (strcmp(arg, "--chebyshev-degree") == 0 && value) {
+            options.chebyshevDegree = atoi(value);
+            if (options.chebyshevDegree < 1 || options.chebyshevDegree > 32) {
+                std::cerr << "Invalid Chebyshev degree: " << value << std::endl;
+                return false;
+            }
+            ++i;
+        } else if (strcmp(arg, "--profile") == 0) {
+            options.profile = true;
+        } else if (strcmp(arg, "--reorder-interval") == 0 && value) {
+            options.reorderInterval = atoi(value);
+            ++i;
+        } else if (strcmp(arg, "--benchmark-order") == 0) {
+            options.benchmarkOrder = true;
+        } else if (strcmp(arg, "--near-field-cutoff") == 0 && value) {
+            options.nearFieldCutoff = atof(value);
+            if (options.nearFieldCutoff <= 0.0) {
+                std::cerr << "Near-field cutoff must be positive" << std::endl;
+                return false;
+            }
+            ++i;
+        } else if (strcmp(arg, "--distributed") == 0 && value) {
+            options.distributedRanks = atoi(value);
+            if (options.distributedRanks < 1 || options.distributedRanks > 256) {
+                std::cerr << "Invalid process count: " << value << std::endl;
+                return false;
+            }
+            ++i;
+        } else if (strcmp(arg, "--transport") == 0 && value) {
+            if (strcmp(value, "socket") == 0) {
+                options.transport = TRANSPORT_SOCKET;
+            } else if (strcmp(value, "shm") == 0) {
+                options.transport = TRANSPORT_SHARED_MEMORY;
+            } else {
+                std::cerr << "Unknown transport: " << value << std::endl;
+                return false;
+            }
+            ++i;
+        } else if (strcmp(arg, "--distributed-steps") == 0 && value) {
+            options.distributedSteps = atoll(value);
+            ++i;
+        } else if (strcmp(arg, "--rebalance-interval") == 0 && value) {
+            options.rebalanceInterval = atoi(value);
+            ++i;
+        } else if (strcmp(arg, "--splat") == 0 && value) {
+            options.splatTarget = value;
+            ++i;
+        } else if (strcmp(arg, "--splat-size") == 0 && value) {
+            if (sscanf(value, "%dx%d", &options.splatWidth, &options.splatHeight) != 2 ||
+                options.splatWidth <= 0 || options.splatHeight <= 0) {
+                std::cerr << "Invalid splat size: " << value << std::endl;
+                return false;
+            }
+            ++i;
+        } else if (strcmp(arg, "--splat-extent") == 0 && value) {
+            options.splatExtent = atof(value);
+            if (options.splatExtent <= 0.0) {
+                std::cerr << "Splat extent must be positive" << std::endl;
+                return false;
+            }
+            ++i;
+        } else if (strcmp(arg, "--splat-frames") == 0 && value) {
+            options.splatFrames = atoi(value);
+            if (options.splatFrames < 1) {
+                std::cerr << "Invalid splat frame count: " << value << std::endl;
+                return false;
+            }
+            ++i;
+        } else if (strcmp(arg, "--splat-interval") == 0 && value) {
+            options.splatInterval = atoi(value);
+            if (options.splatInterval < 1) {
+                std::cerr << "Invalid splat interval: " << value << std::endl;
+                return false;
+            }
+            ++i;
+        } else {
+            std::cerr << "Unknown option: " << arg << std::endl;
+            printUsage(argv[0]);
+            return false;
+        }
+    }
+
+    // Le format d'éphémérides suppose un nombre de corps constant
+    if (options.recordPath && options.collisionMode == COLLISION_MERGE) {
+        std::cerr << "--record cannot be combined with --collisions merge" << std::endl;
+        return false;
+    }
+    if (options.asyncPhysics && options.playbackPath) {
+        std::cerr << "--async-physics cannot be combined with --playback" << std::endl;
+        return false;
+    }
+    if (options.frameBudget > 0.0 && options.captureTarget) {
+        std::cerr << "--dynamic-resolution cannot be combined with --capture" << std::endl;
+        return false;
+    }
+    if (options.captureTarget && options.captureTarget[0] != '|' && strchr(options.captureTarget, '%') &&
+        framePatternNumbers(options.captureTarget) != 1) {
+        std::cerr << "--capture pattern needs exactly one %d (use %% for a literal %)" << std::endl;
+        return false;
+    }
+    if (options.splatTarget) {
+        int numbers = framePatternNumbers(options.splatTarget);
+        if (numbers < 0 || numbers > 1) {
+            std::cerr << "--splat pattern allows a single %d (use %% for a literal %)" << std::endl;
+            return false;
+        }
+        if (options.splatFrames > 1 && numbers == 0) {
+            std::cerr << "--splat-frames above 1 needs a %d pattern in --splat" << std::endl;
+            return false;
+        }
+        // Aperçus de grands nuages de débris : la somme directe n'est gardée que si elle est demandée
+        if (!forcesGiven) {
+            options.forceMethod = FORCE_BARNES_HUT;
+        }
+    }
+    if (options.recordPath && options.playbackPath) {
+        std::cerr << "--record cannot be combined with --playback" << std::endl;
+        return false;
+    }
+    if (options.adaptiveTolerance > 0.0 && options.playbackPath) {
+        std::cerr << "--adaptive-dt cannot be combined with --playback" << std::endl;
+        return false;
+    }
+    if (options.adaptiveTolerance > 0.0 && options.integrator != INTEGRATOR_EULER) {
+        std::cerr << "--adaptive-dt only applies to --integrator euler" << std::endl;
+        return false;
+    }
+    if (options.dtMin > options.dtMax) {
+        std::cerr << "--dt-min must not exceed --dt-max" << std::endl;
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,103 @@
+// Options.h
+#ifndef OPTIONS_H
+#define OPTIONS_H
+
+#include "Collision.h"
+#include "Physics.h"
+#include "Transport.h"
+#include <string>
+
+enum RendererBackend {
+    RENDERER_LEGACY, // Pipeline fixe (glBegin/glEnd, GLU), contexte de compatibilité
+    RENDERER_CORE    // OpenGL 3.3 core : shaders, VAO, UBO
+};
+
+enum DepthMode {
+    DEPTH_STANDARD,   // Profondeur fixe 24 bits, plans proche et lointain classiques
+    DEPTH_REVERSE_Z,  // Profondeur flottante inversée, plan lointain à l'infini (glClipControl)
+    DEPTH_LOGARITHMIC // Profondeur logarithmique écrite par les shaders (rendu core)
+};
+
+// Options de la simulation, lues sur la ligne de commande
+struct SimulationOptions {
+    CollisionMode collisionMode; // Réponse aux collisions (désactivée par défaut)
+    double restitution;          // Coefficient de restitution pour les rebonds (1 = élastique)
+    int debrisCount;             // Nombre de débris ajoutés dans la ceinture d'astéroïdes
+    unsigned int seed;           // Graine du générateur aléatoire
+    int threads;                 // Threads pour le pas de simulation (0 = tous les cœurs)
+    bool deterministic;          // Résultats identiques bit à bit quel que soit le nombre de threads
+    bool numa;                   // Fixer les threads nœud NUMA par nœud
+    bool benchmarkNuma;          // Comparer placement naïf et placement NUMA, sans fenêtre
+    ForceMethod forceMethod;     // Somme directe ou Barnes-Hut
+    double theta;                // Critère d'ouverture de Barnes-Hut (taille / distance)
+    SofteningKernel softening;   // Adoucissement de la gravité à courte distance
+    double softeningLength;      // Longueur d'adoucissement minimale de chaque corps (en mètres)
+    double softeningRadius;      // Longueur d'au moins ce multiple du rayon du corps
+    int hashInterval;            // Journaliser l'empreinte de l'état tous les N pas (0 = jamais)
+    int diagnosticsInterval;     // Journaliser énergie et moments tous les N pas (0 = jamais)
+    double energyAlert;          // Dérive relative de l'énergie au-delà de laquelle une alerte est émise
+    double momentumAlert;        // Même seuil pour la quantité de mouvement et le moment cinétique
+    double dt;                   // Pas de temps (en secondes), pas initial si le pas est adaptatif
+    double adaptiveTolerance;    // Erreur relative visée par pas du pas adaptatif (0 = pas fixe)
+    double dtMin;                // Bornes du pas adaptatif (en secondes)
+    double dtMax;
+    IntegratorKind integrator;   // Schéma d'intégration de la simulation interactive
+    double ias15Epsilon;         // Tolérance de l'erreur relative d'un pas IAS15
+    double encounterRadius;      // Intégrateur hybride : distance de rencontre en rayons de Hill
+    int ensembleMembers;         // Membres de l'ensemble Monte-Carlo (0 = simulation interactive)
+    long long ensembleSteps;     // Nombre de pas simulés par membre
+    double ensemblePerturbation; // Écart-type relatif des perturbations initiales
+    const char* ensembleOutput;  // Fichier CSV des résumés (sortie standard si nul)
+    RendererBackend renderer;    // Chemin de rendu
+    DepthMode depthMode;         // Répartition de la précision du tampon de profondeur
+    int benchmarkFrames;         // Mesurer N images puis quitter (0 = désactivé)
+    const char* captureTarget;   // Capture hors écran : fichier RGBA brut, "|commande" ou motif %d (PPM)
+    int captureWidth;            // Taille des images capturées
+    int captureHeight;
+    long long captureFrames;     // Quitter après N images capturées (0 = jusqu'à la fermeture)
+    bool headless;               // Fenêtre cachée, aucune présentation à l'écran
+    int windowWidth;             // Taille de la fenêtre (en coordonnées d'écran, agrandie sur les écrans
+    int windowHeight;            // haute densité)
+    bool fullscreen;             // Plein écran sur le moniteur principal, à sa résolution
+    double frameBudget;          // Résolution dynamique : temps GPU visé par image en ms (0 = désactivée)
+    double minResolutionScale;   // Fraction minimale de la résolution de la fenêtre
+    bool asyncPhysics;           // Pas de simulation sur un thread à part, le rendu lit des instantanés
+    int physicsStepsPerFrame;    // Pas au plus par image rendue en mode asynchrone (0 = sans limite)
+    bool occlusionCulling;       // Ne pas dessiner les corps cachés derrière les grands corps proches
+    const char* recordPath;      // Enregistrer les éphémérides échantillonnées dans ce fichier
+    int recordInterval;          // Un échantillon tous les N pas
+    const char* playbackPath;    // Relire un fichier d'éphémérides au lieu d'intégrer
+    double playbackSpeed;        // Multiple de la cadence de simulation (--dt par image)
+    const char* compressOutput;  // Compresser le fichier de --playback en séries de Tchebychev, sans fenêtre
+    double chebyshevTolerance;   // Écart maximal toléré (en mètres)
+    double chebyshevWindow;      // Durée initiale des fenêtres (en jours)
+    int chebyshevDegree;         // Degré maximal des séries
+    bool profile;                // Afficher les compteurs du profiler en fin d'exécution
+    int reorderInterval;         // Ranger les corps dans l'ordre de Morton tous les N pas (0 = jamais)
+    bool benchmarkOrder;         // Mesurer la passe à courte portée avant et après le rangement, sans fenêtre
+    double nearFieldCutoff;      // Portée de cette passe (en unités astronomiques)
+    int distributedRanks;        // Processus de la simulation distribuée, sans fenêtre (0 = désactivée)
+    TransportKind transport;     // Canaux entre ces processus
+    long long distributedSteps;  // Nombre de pas simulés
+    int rebalanceInterval;       // Redécouper les domaines selon la charge tous les N pas
+    const char* splatTarget;     // Aperçus rastérisés sur CPU, sans fenêtre : fichier PPM ou motif %d
+    int splatWidth;              // Taille de ces aperçus
+    int splatHeight;
+    double splatExtent;          // Demi-largeur de la vue (en unités astronomiques)
+    int splatFrames;             // Nombre d'aperçus
+    int splatInterval;           // Pas simulés entre deux aperçus
+
+    SimulationOptions();
+};
+
+// Retourne false si les arguments sont invalides (l'usage est alors affiché)
+bool parseOptions(int argc, char** argv, SimulationOptions& options);
+void printUsage(const char* program);
+
+// Motifs de fichiers numérotés (--capture, --splat) : %d est remplacé par le numéro de l'image et %%
+// donne un %. Le motif n'est jamais passé à printf. Retourne le nombre de %d, ou -1 pour toute
+// autre conversion.
+int framePatternNumbers(const char* pattern);
+std::string framePath(const std::string& pattern, long long index);
+
+#endif // OPTIONS_H
@@ -0,0 +1,35 @@
+// Parallel.cpp
+#include "Parallel.h"
+#include "Scheduler.h"
+#include <thread>
+
+int resolveThreadCount(int requested) {
+    if (requested > 0) {
+        return requested;
+    }
+    unsigned int hardware = std::thread::hardware_concurrency();
+    return hardware > 0 ? static_cast<int>(hardware) : 1;
+}
+
+void parallelFor(size_t count, int threads, const std::function<void(size_t, size_t, int)>& body) {
+    if (threads <= 1 || count <= 1) {
+        body(0, count, 0);
+        return;
+    }
+    if (static_cast<size_t>(threads) > count) {
+        threads = static_cast<int>(count);
+    }
+
+    // Tranches 1 à threads - 1 confiées à l'ordonnanceur, la tranche w dans la file du thread w :
+    // avec des threads fixés nœud par nœud, chaque tranche reste sur le nœud où ses pages ont été
+    // touchées. L'appelant traite la tranche 0 puis aide.
+    schedulerReserve(threads - 1);
+    std::atomic<int> pending(threads - 1);
+    for (int w = 1; w < threads; ++w) {
+        size_t begin = count * w / threads;
+        size_t end = count * (w + 1) / threads;
+        schedulerSubmitTo(w, [&body, begin, end, w] { body(begin, end, w); }, &pending);
+    }
+    body(0, count / threads, 0);
+    schedulerWait(pending);
+}
@@ -0,0 +1,17 @@
+// Parallel.h
+#ifndef PARALLEL_H
+#define PARALLEL_H
+
+#include <cstddef>
+#include <functional>
+
+// Nombre de threads effectif : 0 signifie « autant que de cœurs »
+int resolveThreadCount(int requested);
+
+// Découpe [0, count) en tranches contiguës, une par thread ; body(begin, end, worker)
+// est appelé avec worker dans [0, threads). Le thread appelant traite la tranche 0 ; les autres
+// sont des tâches de l'ordonnanceur (Scheduler.h), si bien que les appels imbriqués dans une
+// tâche sont permis.
+void parallelFor(size_t count, int threads, const std::function<void(size_t, size_t, int)>& body);
+
+#endif // PARALLEL_H
@@ -0,0 +1,290 @@
+// Physics.cpp
+#include "Physics.h"
+#include "Parallel.h"
+#include "Arena.h"
+#include "BarnesHut.h"
+#include <algorithm>
+#include <cmath>
+
+static void computeForcesSerial(std::vector<Planet>& planets, double* potential) {
+    SofteningKernel kernel = softeningKernel();
+    double energy = 0.0;
+    for (size_t i = 0; i < planets.size(); ++i) {
+        for (size_t j = i + 1; j < planets.size(); ++j) {
+            double fx, fy, fz, pair;
+            computeGravitationalForce(planets[i], planets[j], fx, fy, fz, kernel, potential ? &pair : nullptr);
+            planets[i].applyForce(fx, fy, fz);
+            planets[j].applyForce(-fx, -fy, -fz);
+            if (potential) {
+                energy += pair;
+            }
+        }
+    }
+    if (potential) {
+        *potential = energy;
+    }
+}
+
+// Chaque thread n'écrit que dans les corps de sa tranche : aucune course, ordre fixe.
+// Chaque paire étant vue des deux côtés, l'énergie potentielle est la demi-somme de celles
+// des corps, sommées dans l'ordre des indices.
+static void computeForcesGather(std::vector<Planet>& planets, int threads, double* potential) {
+    size_t n = planets.size();
+    SofteningKernel kernel = softeningKernel();
+    double* bodyPotential = potential ? stepArena().allocateZeroed<double>(n) : nullptr;
+    parallelFor(n, threads, [&planets, n, kernel, bodyPotential](size_t begin, size_t end, int) {
+        for (size_t k = begin; k < end; ++k) {
+            Planet& p = planets[k];
+            double energy = 0.0;
+            for (size_t j = 0; j < n; ++j) {
+                double fx, fy, fz, pair = 0.0;
+                if (j < k) { // Même évaluation (et même signe) que la boucle séquentielle
+                    computeGravitationalForce(planets[j], p, fx, fy, fz, kernel, bodyPotential ? &pair : nullptr);
+                    p.applyForce(-fx, -fy, -fz);
+                } else if (j > k) {
+                    computeGravitationalForce(p, planets[j], fx, fy, fz, kernel, bodyPotential ? &pair : nullptr);
+                    p.applyForce(fx, fy, fz);
+                }
+                energy += pair;
+            }
+            if (bodyPotential) {
+                bodyPotential[k] = energy;
+            }
+        }
+    });
+    if (potential) {
+        double energy = 0.0;
+        for (size_t k = 0; k < n; ++k) {
+            energy += bodyPotential[k];
+        }
+        *potential = 0.5 * energy;
+    }
+}
+
+// Paires évaluées une seule fois dans des accumulateurs privés, puis réduction.
+// Les accumulateurs vivent dans l'arène du pas : aucune allocation par pas en régime établi.
+static void computeForcesSymmetric(std::vector<Planet>& planets, int threads, double* potential) {
+    size_t n = planets.size();
+    double* acc = stepArena().allocateZeroed<double>(static_cast<size_t>(threads) * n * 3);
+    double* partial = potential ? stepArena().allocateZeroed<double>(threads) : nullptr;
+    SofteningKernel kernel = softeningKernel();
+
+    // Lignes distribuées de façon cyclique pour équilibrer la boucle triangulaire
+    parallelFor(threads, threads, [&planets, acc, partial, n, threads, kernel](size_t begin, size_t end, int) {
+        for (size_t w = begin; w < end; ++w) {
+            double* a = &acc[w * n * 3];
+            double energy = 0.0;
+            for (size_t i = w; i < n; i += threads) {
+                for (size_t j = i + 1; j < n; ++j) {
+                    double fx, fy, fz, pair = 0.0;
+                    computeGravitationalForce(planets[i], planets[j], fx, fy, fz, kernel, partial ? &pair : nullptr);
+                    a[3*i] += fx / planets[i].mass;
+                    a[3*i + 1] += fy / planets[i].mass;
+                    a[3*i + 2] += fz / planets[i].mass;
+                    a[3*j] -= fx / planets[j].mass;
+                    a[3*j + 1] -= fy / planets[j].mass;
+                    a[3*j + 2] -= fz / planets[j].mass;
+                    energy += pair;
+                }
+            }
+            if (partial) {
+                partial[w] = energy;
+            }
+        }
+    });
+
+    parallelFor(n, threads, [&planets, acc, n, threads](size_t begin, size_t end, int) {
+        for (size_t k = begin; k < end; ++k) {
+            for (int w = 0; w < threads; ++w) {
+                const double* a = &acc[(w * n + k) * 3];
+                planets[k].ax += a[0];
+                planets[k].ay += a[1];
+                planets[k].az += a[2];
+            }
+        }
+    });
+    if (potential) {
+        *potential = 0.0;
+        for (int w = 0; w < threads; ++w) {
+            *potential += partial[w];
+        }
+    }
+}
+
+void computeForces(std::vector<Planet>& planets, int threads, bool deterministic, double* potential) {
+    threads = resolveThreadCount(threads);
+    if (deterministic) {
+        computeForcesGather(planets, threads, potential);
+    } else if (threads <= 1 || planets.size() < 2 * static_cast<size_t>(threads)) {
+        computeForcesSerial(planets, potential);
+    } else {
+        computeForcesSymmetric(planets, threads, potential);
+    }
+}
+
+double bodySoftening(double radius, double length, double radiusFactor) {
+    return std::max(length, radiusFactor * radius);
+}
+
+void assignSoftening(std::vector<Planet>& planets, double length, double radiusFactor) {
+    for (auto& planet : planets) {
+        planet.softening = bodySoftening(planet.radius, length, radiusFactor);
+    }
+}
+
+void hashDoubles(uint64_t& hash, const double* values, size_t count) {
+    const unsigned char* bytes = reinterpret_cast<const unsigned char*>(values);
+    for (size_t k = 0; k < count * sizeof(double); ++k) {
+        hash ^= bytes[k];
+        hash *= 1099511628211ULL; // Nombre premier FNV 64 bits
+    }
+}
+
+TaskGraph::TaskId addForceTasks(TaskGraph& graph, std::vector<Planet>& planets, ForceMethod method, double theta,
+                                int threads, bool deterministic, double* potential) {
+    if (method == FORCE_DIRECT) {
+        return graph.add([&planets, threads, deterministic, potential] {
+            computeForces(planets, threads, deterministic, potential);
+        });
+    }
+
+    // L'arbre est rempli par la tâche de construction et lu par les tuiles ; chaque tuile écrit
+    // son énergie potentielle à part, sommée dans l'ordre des tuiles par la tâche finale
+    size_t tiles = (planets.size() + BARNES_HUT_TILE - 1) / BARNES_HUT_TILE;
+    BarnesHutTree* tree = stepArena().allocateArray<BarnesHutTree>(1);
+    double* tilePotential = potential ? stepArena().allocateZeroed<double>(tiles) : nullptr;
+    TaskGraph::TaskId build = graph.add([&planets, tree] { buildBarnesHutTree(planets, *tree); });
+    TaskGraph::TaskId done = graph.add([potential, tilePotential, tiles] {
+        if (potential) {
+            *potential = 0.0;
+            for (size_t t = 0; t < tiles; ++t) {
+                *potential += tilePotential[t];
+            }
+        }
+    });
+    for (size_t t = 0; t < tiles; ++t) {
+        size_t begin = t * BARNES_HUT_TILE;
+        size_t end = std::min(planets.size(), begin + BARNES_HUT_TILE);
+        double* slot = tilePotential ? &tilePotential[t] : nullptr;
+        TaskGraph::TaskId tile = graph.add([&planets, tree, begin, end, theta, slot] {
+            barnesHutForces(*tree, planets, begin, end, theta, slot);
+        });
+        graph.precede(build, tile);
+        graph.precede(tile, done);
+    }
+    graph.precede(build, done);
+    return done;
+}
+
+TaskGraph::TaskId addIntegrationTasks(TaskGraph& graph, std::vector<Planet>& planets, double dt,
+                                      TaskGraph::TaskId after) {
+    TaskGraph::TaskId done = graph.add([] {});
+    for (size_t begin = 0; begin < planets.size(); begin += INTEGRATION_TILE) {
+        size_t end = std::min(planets.size(), begin + INTEGRATION_TILE);
+        TaskGraph::TaskId tile = graph.add([&planets, begin, end, dt] {
+            for (size_t k = begin; k < end; ++k) {
+                planets[k].update(dt);
+            }
+        });
+        graph.precede(after, tile);
+        graph.precede(tile, done);
+    }
+    graph.precede(after, done);
+    return done;
+}
+
+struct TileBounds {
+    double lo[3], hi[3];
+};
+
+static double tileDistanceSquared(const TileBounds& a, const TileBounds& b) {
+    double d2 = 0.0;
+    for (int c = 0; c < 3; ++c) {
+        double gap = std::max(a.lo[c] - b.hi[c], b.lo[c] - a.hi[c]);
+        if (gap > 0.0) {
+            d2 += gap * gap;
+        }
+    }
+    return d2;
+}
+
+size_t computeNearFieldForces(std::vector<Planet>& planets, double cutoff, int threads) {
+    threads = resolveThreadCount(threads);
+    size_t n = planets.size();
+    size_t tiles = (n + NEAR_FIELD_TILE - 1) / NEAR_FIELD_TILE;
+    Arena& arena = stepArena();
+    TileBounds* bounds = arena.allocateArray<TileBounds>(tiles);
+    size_t* evaluated = arena.allocateZeroed<size_t>(threads);
+
+    for (size_t t = 0; t < tiles; ++t) {
+        TileBounds& box = bounds[t];
+        const Planet& first = planets[t * NEAR_FIELD_TILE];
+        box.lo[0] = box.hi[0] = first.x;
+        box.lo[1] = box.hi[1] = first.y;
+        box.lo[2] = box.hi[2] = first.z;
+        size_t end = std::min(n, (t + 1) * NEAR_FIELD_TILE);
+        for (size_t k = t * NEAR_FIELD_TILE + 1; k < end; ++k) {
+            const double position[3] = { planets[k].x, planets[k].y, planets[k].z };
+            for (int c = 0; c < 3; ++c) {
+                box.lo[c] = std::min(box.lo[c], position[c]);
+                box.hi[c] = std::max(box.hi[c], position[c]);
+            }
+        }
+    }
+
+    const double cutoff2 = cutoff * cutoff;
+    SofteningKernel kernel = softeningKernel();
+    parallelFor(tiles, threads, [&planets, bounds, evaluated, tiles, n, cutoff2, kernel](size_t begin, size_t end, int worker) {
+        size_t count = 0;
+        for (size_t a = begin; a < end; ++a) {
+            size_t aEnd = std::min(n, (a + 1) * NEAR_FIELD_TILE);
+            for (size_t b = 0; b < tiles; ++b) {
+                if (tileDistanceSquared(bounds[a], bounds[b]) > cutoff2) {
+                    continue;
+                }
+                size_t bEnd = std::min(n, (b + 1) * NEAR_FIELD_TILE);
+                for (size_t i = a * NEAR_FIELD_TILE; i < aEnd; ++i) {
+                    Planet& p = planets[i];
+                    for (size_t j = b * NEAR_FIELD_TILE; j < bEnd; ++j) {
+                        const Planet& q = planets[j];
+                        double dx = q.x - p.x, dy = q.y - p.y, dz = q.z - p.z;
+                        if (j == i || dx*dx + dy*dy + dz*dz > cutoff2) {
+                            continue;
+                        }
+                        double fx, fy, fz;
+                        computeGravitationalForce(p, q, fx, fy, fz, kernel);
+                        p.applyForce(fx, fy, fz);
+                        ++count;
+                    }
+                }
+            }
+        }
+        evaluated[worker] += count;
+    });
+
+    size_t total = 0;
+    for (int w = 0; w < threads; ++w) {
+        total += evaluated[w];
+    }
+    return total;
+}
+
+static bool idLess(const Planet* a, const Planet* b) {
+    return a->id < b->id;
+}
+
+uint64_t stateHash(const std::vector<Planet>& planets) {
+    // Dans l'ordre des identifiants, pour que la réorganisation du tableau ne change pas l'empreinte
+    std::vector<const Planet*> order(planets.size());
+    for (size_t k = 0; k < planets.size(); ++k) {
+        order[k] = &planets[k];
+    }
+    std::sort(order.begin(), order.end(), idLess);
+
+    uint64_t hash = STATE_HASH_BASIS;
+    for (const Planet* p : order) {
+        const double values[7] = { p->x, p->y, p->z, p->vx, p->vy, p->vz, p->mass };
+        hashDoubles(hash, values, 7);
+    }
+    return hash;
+}
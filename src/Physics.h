@@ -0,0 +1,69 @@
+// Physics.h
+#ifndef PHYSICS_H
+#define PHYSICS_H
+
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include "Planet.h"
+#include "Scheduler.h"
+
+enum ForceMethod {
+    FORCE_DIRECT,    // Toutes les paires (computeForces)
+    FORCE_BARNES_HUT // Octree, O(n log n), précision réglée par theta
+};
+
+enum IntegratorKind {
+    INTEGRATOR_EULER, // Euler symplectique par tuiles (Planet::update), pas fixe ou --adaptive-dt
+    INTEGRATOR_IAS15, // Gauss-Radau d'ordre 15 à pas adaptatif (Ias15.h)
+    INTEGRATOR_HYBRID // Saute-mouton, IAS15 pour les seules paires en rencontre proche (Hybrid.h)
+};
+
+// Accumule dans ax/ay/az les accélérations gravitationnelles de toutes les paires.
+// Mode rapide : chaque paire est évaluée une fois, les sommes partielles par thread sont
+// réduites ensuite ; le résultat dépend donc du nombre de threads.
+// Mode déterministe : chaque corps somme ses contributions dans l'ordre croissant des
+// indices, ce qui reproduit bit à bit la boucle séquentielle quel que soit le nombre de
+// threads (au prix de deux évaluations par paire).
+// Les accumulateurs du mode rapide sont pris dans stepArena() : appel depuis le thread du pas.
+// potential, si non nul, reçoit l'énergie potentielle totale, sommée dans la même boucle de paires.
+void computeForces(std::vector<Planet>& planets, int threads, bool deterministic, double* potential = nullptr);
+
+// Ajoute au graphe le calcul des accélérations de tous les corps et retourne la tâche qui le
+// termine. Barnes-Hut : construction de l'arbre puis une tâche par tuile de BARNES_HUT_TILE corps,
+// que le vol de tâches répartit quel que soit le coût de chaque tuile. Direct : une tâche qui
+// appelle computeForces. planets ne doit pas changer de taille avant l'exécution du graphe.
+// potential, si non nul, reçoit l'énergie potentielle quand la tâche retournée est terminée
+// (Barnes-Hut : celle du parcours de l'arbre, approchée comme les forces).
+TaskGraph::TaskId addForceTasks(TaskGraph& graph, std::vector<Planet>& planets, ForceMethod method, double theta,
+                                int threads, bool deterministic, double* potential = nullptr);
+
+// Ajoute l'intégration (Planet::update, trajectoires comprises) par tuiles de corps, après after ;
+// retourne la tâche qui la termine
+const size_t INTEGRATION_TILE = 1024;
+TaskGraph::TaskId addIntegrationTasks(TaskGraph& graph, std::vector<Planet>& planets, double dt,
+                                      TaskGraph::TaskId after);
+
+// Interactions à courte portée : seules les paires à moins de cutoff mètres sont évaluées.
+// Les corps sont groupés en tuiles de NEAR_FIELD_TILE indices consécutifs et une paire de tuiles
+// dont les boîtes englobantes sont à plus de cutoff est écartée d'un bloc ; l'efficacité dépend
+// donc de la localité spatiale de l'ordre du tableau (voir sortBodiesMorton).
+// Chaque thread n'écrit que dans ses propres tuiles. Retourne le nombre de paires évaluées.
+const size_t NEAR_FIELD_TILE = 64;
+size_t computeNearFieldForces(std::vector<Planet>& planets, double cutoff, int threads);
+
+// Longueur d'adoucissement d'un corps : max(length, radiusFactor * rayon), pour adoucir les gros
+// corps à l'échelle de leur taille (le noyau lui-même est choisi par setSofteningKernel)
+double bodySoftening(double radius, double length, double radiusFactor);
+void assignSoftening(std::vector<Planet>& planets, double length, double radiusFactor);
+
+// Empreinte FNV-1a des positions, vitesses et masses, pour comparer deux exécutions ;
+// les corps sont pris dans l'ordre de leurs identifiants
+uint64_t stateHash(const std::vector<Planet>& planets);
+
+// Ajoute des valeurs à une empreinte FNV-1a commencée à STATE_HASH_BASIS ; stateHash
+// hache pour chaque corps x, y, z, vx, vy, vz puis la masse
+const uint64_t STATE_HASH_BASIS = 14695981039346656037ULL;
+void hashDoubles(uint64_t& hash, const double* values, size_t count);
+
+#endif // PHYSICS_H
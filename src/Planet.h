@@ -2,9 +2,16 @@
 #ifndef PLANET_H
 #define PLANET_H
 
+#include <cstddef>
 #include <vector>
 #include <utility>
 #include <GL/glew.h>
+#include "Lod.h"
+#include "RingSystem.h"
+#include "Softening.h"
+#include "Trajectory.h"
+
+class RenderQueue;
 
 const double G = 6.67430e-11; // m^3 kg^-1 s^-2
 const double AU = 1.496e11; // Unité astronomique en mètres (distance moyenne Terre-Soleil)
@@ -18,23 +25,39 @@ public:
     double ax, ay, az;   // Accélération de la planète (en mètres par seconde carré)
     double mass;         // Masse de la planète (en kg)
     double radius;       // Rayon de la planète (en mètres)
+    double softening;    // Longueur d'adoucissement gravitationnel (en mètres, voir Softening.h)
     float r, g, b;       // Couleur de la planète
     double rotationSpeed; // Vitesse de rotation (radians par seconde)
     double rotationAngle; // Angle de rotation actuel (radians)
+    unsigned int id;     // Identifiant stable : indice du corps à sa création, conservé quand le tableau est réordonné
     
     GLuint texture;      // Texture de la planète
-    unsigned int ringTexture; // Texture des anneaux
-    std::vector<std::pair<double, double>> trajectory; // Trajectoire pour le tracé
+    RingSystem rings;    // Anneaux éventuels (maillage partagé entre les copies)
+    Trajectory trajectory; // Trajectoire pour le tracé
 
-    Planet(double _x, double _y, double _z, double _radius, double _mass, float _r, float _g, float _b, const char* texturePath, double _rotationSpeed = 0.0, const char* ringTexturePath = nullptr);
+    Planet(double _x, double _y, double _z, double _radius, double _mass, float _r, float _g, float _b, const char* texturePath, double _rotationSpeed = 0.0);
 
     void applyForce(double fx, double fy, double fz);
     void update(double dt);
-    void draw() const;
-    void drawRings() const;
+    void advance(double dt); // Comme update, sans ajouter de point à la trajectoire
+    void rotate(double dt);  // Avance seulement l'angle de rotation (intégrateurs qui posent x et v eux-mêmes)
+    void appendTrajectory(); // Ajoute la position courante à la trajectoire
+    double boundingRadius() const; // Sphère englobante, anneaux compris (en mètres)
+
+    // Pipeline fixe : ajoute les éléments visibles du corps à la file de rendu
+    void enqueue(const RenderView& view, RenderQueue& queue) const;
+
+    // Dessin sans changement d'état, appelé par la file de rendu une fois l'état positionné
+    void drawBody(LodLevel lod) const;
+    void drawPoint() const;
+    void drawRings(LodLevel lod) const;
+    void drawTrajectory(const Frustum& frustum) const;
 
 };
 
-void computeGravitationalForce(const Planet& p1, const Planet& p2, double& fx, double& fy, double& fz);
+// Force exercée par p2 sur p1, adoucie par le noyau kernel à la longueur de la paire.
+// potential, si non nul, reçoit l'énergie potentielle de la paire (en joules).
+void computeGravitationalForce(const Planet& p1, const Planet& p2, double& fx, double& fy, double& fz,
+                               SofteningKernel kernel, double* potential = nullptr);
 
 #endif // PLANET_H
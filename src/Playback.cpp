@@ -0,0 +1,178 @@
+// Playback.cpp
+#include "Playback.h"
+#include "SolarSystem.h"
+#include <cmath>
+
+static const int playbackKeys[4] = { GLFW_KEY_SPACE, GLFW_KEY_LEFT_BRACKET, GLFW_KEY_RIGHT_BRACKET, GLFW_KEY_R };
+static const double SCRUB_FRACTION = 0.01; // Part de la durée enregistrée parcourue par image de défilement rapide
+
+Playback::Playback() : useCompressed(false), current(0.0), speed(1.0), frameStep(0.0), paused(false), jumped(true) {
+    for (int k = 0; k < 4; ++k) {
+        keyWasDown[k] = false;
+    }
+}
+
+bool Playback::open(const char* path, double playbackSpeed) {
+    useCompressed = isChebyshevEphemeris(path);
+    if (useCompressed ? !compressed.open(path) : !reader.open(path)) {
+        return false;
+    }
+    current = startTime();
+    speed = playbackSpeed;
+    paused = false;
+    jumped = true;
+    return true;
+}
+
+void Playback::close() {
+    reader.close();
+    compressed.close();
+}
+
+size_t Playback::bodyCount() const {
+    return useCompressed ? compressed.bodyCount() : reader.bodyCount();
+}
+
+const EphemerisBody& Playback::body(size_t index) const {
+    return useCompressed ? compressed.body(index) : reader.body(index);
+}
+
+double Playback::startTime() const {
+    return useCompressed ? compressed.startTime() : reader.startTime();
+}
+
+double Playback::endTime() const {
+    return useCompressed ? compressed.endTime() : reader.endTime();
+}
+
+void Playback::evaluate(double t, std::vector<double>& result) const {
+    if (useCompressed) {
+        compressed.evaluate(t, result);
+    } else {
+        reader.evaluate(t, result);
+    }
+}
+
+void Playback::createBodies(std::vector<Planet>& planets) const {
+    const std::vector<BodyDefinition>& definitions = solarSystemDefinition();
+    std::vector<double> initial;
+    evaluate(startTime(), initial);
+    for (size_t k = 0; k < bodyCount(); ++k) {
+        const EphemerisBody& info = body(k);
+        const double* state = &initial[6 * k];
+        if (info.definition >= 0 && info.definition < static_cast<int32_t>(definitions.size())) {
+            BodyState bodyState = { state[0], state[1], state[2], state[3], state[4], state[5], info.mass, info.radius };
+            addDefinedBody(planets, definitions[info.definition], bodyState);
+        } else {
+            planets.emplace_back(state[0], state[1], state[2], info.radius, info.mass, info.r, info.g, info.b, nullptr);
+            planets.back().id = static_cast<unsigned int>(planets.size() - 1);
+        }
+    }
+}
+
+void Playback::handleInput(GLFWwindow* window) {
+    for (int k = 0; k < 4; ++k) {
+        bool down = glfwGetKey(window, playbackKeys[k]) == GLFW_PRESS;
+        if (down && !keyWasDown[k]) {
+            switch (k) {
+            case 0: paused = !paused; break;
+            case 1: speed *= 0.5; break;
+            case 2: speed *= 2.0; break;
+            case 3: speed = -speed; break;
+            }
+        }
+        keyWasDown[k] = down;
+    }
+
+    double span = endTime() - startTime();
+    if (glfwGetKey(window, GLFW_KEY_RIGHT) == GLFW_PRESS) {
+        seek(current + span * SCRUB_FRACTION);
+    }
+    if (glfwGetKey(window, GLFW_KEY_LEFT) == GLFW_PRESS) {
+        seek(current - span * SCRUB_FRACTION);
+    }
+}
+
+void Playback::seek(double t) {
+    double start = startTime(), end = endTime();
+    current = t < start ? start : (t > end ? end : t);
+    jumped = true;
+}
+
+double Playback::advance(double frameDt) {
+    frameStep = fabs(speed * frameDt);
+    if (paused) {
+        return current;
+    }
+    double start = startTime(), end = endTime();
+    double next = current + speed * frameDt;
+    if (next > end || next < start) {
+        // Reprendre à l'autre extrémité ; les trajectoires sont reconstruites
+        next = next > end ? start : end;
+        jumped = true;
+    }
+    current = next;
+    return current;
+}
+
+double Playback::time() const {
+    return current;
+}
+
+void Playback::update(std::vector<Planet>& planets) {
+    evaluate(current, states);
+    for (size_t k = 0; k < planets.size() && k < bodyCount(); ++k) {
+        Planet& planet = planets[k];
+        const double* state = &states[6 * k];
+        planet.x = state[0]; planet.y = state[1]; planet.z = state[2];
+        planet.vx = state[3]; planet.vy = state[4]; planet.vz = state[5];
+        planet.rotationAngle = fmod(planet.rotationSpeed * current, 2 * M_PI);
+    }
+
+    if (jumped) {
+        rebuildTrajectories(planets);
+        jumped = false;
+    } else if (!paused) {
+        for (auto& planet : planets) {
+            planet.appendTrajectory();
+        }
+    }
+}
+
+// Après un saut, la trajectoire reprend les derniers échantillons enregistrés avant l'instant courant ;
+// un fichier compressé n'a pas d'échantillons, il est alors évalué à la cadence des images
+void Playback::rebuildTrajectories(std::vector<Planet>& planets) {
+    size_t n = planets.size() < bodyCount() ? planets.size() : bodyCount();
+    for (size_t k = 0; k < n; ++k) {
+        planets[k].trajectory.clear();
+    }
+
+    if (useCompressed) {
+        double step = frameStep > 0.0 ? frameStep : (endTime() - startTime()) / TRAJECTORY_LENGTH;
+        size_t count = static_cast<size_t>((current - startTime()) / step) + 1;
+        if (count > TRAJECTORY_LENGTH) {
+            count = TRAJECTORY_LENGTH;
+        }
+        std::vector<double> past;
+        for (size_t i = count; i-- > 0;) {
+            evaluate(current - i * step, past);
+            for (size_t k = 0; k < n; ++k) {
+                planets[k].trajectory.push(past[6 * k] / AU, past[6 * k + 1] / AU);
+            }
+        }
+        return;
+    }
+
+    size_t last = reader.findSample(current);
+    if (last + 1 < reader.sampleCount() && reader.time(last + 1) <= current) {
+        ++last; // findSample s'arrête à l'avant-dernier échantillon
+    }
+    size_t first = last + 1 > TRAJECTORY_LENGTH ? last + 1 - TRAJECTORY_LENGTH : 0;
+    for (size_t k = 0; k < n; ++k) {
+        Planet& planet = planets[k];
+        for (size_t sample = first; sample <= last; ++sample) {
+            const double* state = reader.sampleState(sample, k);
+            planet.trajectory.push(state[0] / AU, state[1] / AU);
+        }
+    }
+}
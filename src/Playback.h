@@ -0,0 +1,56 @@
+// Playback.h
+#ifndef PLAYBACK_H
+#define PLAYBACK_H
+
+#include <vector>
+#include <GLFW/glfw3.h>
+#include "ChebyshevEphemeris.h"
+#include "Ephemeris.h"
+#include "Planet.h"
+
+// Relecture d'un fichier d'éphémérides (échantillonné ou compressé en séries de Tchebychev) à la place
+// de l'intégration : aucune force n'est calculée, les positions sont évaluées à l'instant affiché,
+// qui peut avancer, reculer ou sauter librement.
+//   Espace : pause   [ / ] : vitesse divisée / multipliée par 2   R : sens inverse
+//   Gauche / droite : recul / avance rapide (1 % de la durée enregistrée par image)
+class Playback {
+public:
+    Playback();
+
+    // speed : secondes simulées par seconde de pas (1 = cadence de la simulation, --dt par image)
+    bool open(const char* path, double speed);
+    void close();
+
+    // Crée les corps enregistrés, avec textures et anneaux pour ceux du système solaire
+    void createBodies(std::vector<Planet>& planets) const;
+
+    void handleInput(GLFWwindow* window);
+
+    // Avance l'horloge d'une image ; boucle au début après la fin de l'enregistrement
+    double advance(double frameDt);
+    double time() const;
+
+    // Positions, vitesses, rotations et trajectoires à l'instant courant
+    void update(std::vector<Planet>& planets);
+
+private:
+    void seek(double t);
+    void rebuildTrajectories(std::vector<Planet>& planets);
+
+    size_t bodyCount() const;
+    const EphemerisBody& body(size_t index) const;
+    double startTime() const;
+    double endTime() const;
+    void evaluate(double t, std::vector<double>& result) const;
+
+    EphemerisReader reader;
+    ChebyshevEphemeris compressed;
+    bool useCompressed;
+    double current, speed;
+    double frameStep; // Temps simulé parcouru par la dernière image (pour reconstruire les trajectoires)
+    bool paused, jumped;
+    bool keyWasDown[4]; // Espace, [, ], R : une action par appui
+    std::vector<double> states;
+};
+
+#endif // PLAYBACK_H
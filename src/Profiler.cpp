@@ -0,0 +1,56 @@
+// Profiler.cpp
+#include "Profiler.h"
+#include <atomic>
+
+static const char* counterNames[PROFILE_COUNTER_COUNT] = {
+    "state_changes",
+    "draw_calls",
+    "capture_stalls",
+    "arena_bytes",
+    "arena_allocations",
+    "arena_grows",
+    "snapshots_dropped",
+    "snapshots_reused",
+    "bodies_drawn",
+    "bodies_culled",
+    "bodies_occluded",
+    "rings_drawn",
+    "rings_culled",
+    "trajectory_chunks_drawn",
+    "trajectory_chunks_culled",
+    "render_pixels",
+};
+
+static std::atomic<long long> current[PROFILE_COUNTER_COUNT];
+static long long total[PROFILE_COUNTER_COUNT];
+static long long peak[PROFILE_COUNTER_COUNT];
+static long long frames = 0;
+
+void profilerAdd(ProfileCounter counter, long long amount) {
+    current[counter].fetch_add(amount, std::memory_order_relaxed);
+}
+
+long long profilerValue(ProfileCounter counter) {
+    return current[counter].load(std::memory_order_relaxed);
+}
+
+void profilerEndFrame() {
+    for (int c = 0; c < PROFILE_COUNTER_COUNT; ++c) {
+        long long value = current[c].exchange(0, std::memory_order_relaxed);
+        total[c] += value;
+        if (value > peak[c]) {
+            peak[c] = value;
+        }
+    }
+    ++frames;
+}
+
+void profilerReport(std::ostream& out) {
+    if (frames == 0) {
+        return;
+    }
+    out << "Profile over " << frames << " frames (mean / max per frame):" << std::endl;
+    for (int c = 0; c < PROFILE_COUNTER_COUNT; ++c) {
+        out << "  " << counterNames[c] << ": " << static_cast<double>(total[c]) / frames << " / " << peak[c] << std::endl;
+    }
+}
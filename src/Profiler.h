@@ -0,0 +1,39 @@
+// Profiler.h
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include <ostream>
+
+// Compteurs d'instrumentation remis à zéro à chaque image ; le profiler garde
+// pour chacun le total et le maximum par image. profilerAdd peut être appelé de n'importe
+// quel thread (le thread du pas avec --async-physics) ; le reste est réservé au thread principal.
+enum ProfileCounter {
+    PROFILE_STATE_CHANGES, // Changements d'état OpenGL effectivement transmis au pilote
+    PROFILE_DRAW_CALLS,    // Appels de dessin
+    PROFILE_CAPTURE_STALLS, // Images où le rendu a attendu le thread d'écriture de la capture
+    PROFILE_ARENA_BYTES,       // Octets alloués dans les arènes du pas et de l'image (le maximum donne le pic)
+    PROFILE_ARENA_ALLOCATIONS, // Allocations dans ces arènes
+    PROFILE_ARENA_GROWS,       // Blocs demandés au système par l'arène (nul en régime établi)
+    PROFILE_SNAPSHOTS_DROPPED, // États publiés par le thread du pas et remplacés avant d'être affichés
+    PROFILE_SNAPSHOTS_REUSED,  // Images dessinées sans nouvel état (le même est réaffiché)
+    PROFILE_BODIES_DRAWN,      // Corps dessinés (sphère ou point)
+    PROFILE_BODIES_CULLED,     // Corps hors de la pyramide de vision
+    PROFILE_BODIES_OCCLUDED,   // Corps cachés derrière un grand corps proche (--occlusion-culling)
+    PROFILE_RINGS_DRAWN,
+    PROFILE_RINGS_CULLED,      // Anneaux hors de la pyramide ou cachés
+    PROFILE_TRAJECTORY_CHUNKS_DRAWN,  // Morceaux de trajectoire tracés
+    PROFILE_TRAJECTORY_CHUNKS_CULLED, // Morceaux hors de la pyramide, sautés
+    PROFILE_RENDER_PIXELS,     // Pixels rendus avec --dynamic-resolution, avant agrandissement
+    PROFILE_COUNTER_COUNT
+};
+
+void profilerAdd(ProfileCounter counter, long long amount = 1);
+long long profilerValue(ProfileCounter counter); // Valeur de l'image en cours
+
+// Clôt l'image en cours : accumule les compteurs puis les remet à zéro
+void profilerEndFrame();
+
+// Moyenne et maximum par image de chaque compteur
+void profilerReport(std::ostream& out);
+
+#endif // PROFILER_H
@@ -0,0 +1,77 @@
+// RenderQueue.cpp
+#include "RenderQueue.h"
+#include "Planet.h"
+#include "Arena.h"
+#include "Profiler.h"
+#include <algorithm>
+
+bool RenderQueue::itemLess(const RenderItem& a, const RenderItem& b) {
+    if (a.pass != b.pass) return a.pass < b.pass;
+    if (a.texture != b.texture) return a.texture < b.texture;
+    if (a.lod != b.lod) return a.lod < b.lod;
+    if (a.pointSize != b.pointSize) return a.pointSize < b.pointSize;
+    return a.planet < b.planet; // Ordre des corps conservé dans un groupe, sans tampon de tri stable
+}
+
+RenderQueue::RenderQueue() : items(NULL), count(0), capacity(0) {}
+
+void RenderQueue::begin(size_t size) {
+    items = frameArena().allocateArray<RenderItem>(size);
+    count = 0;
+    capacity = size;
+}
+
+void RenderQueue::push(const RenderItem& item) {
+    if (count < capacity) {
+        items[count++] = item;
+    }
+}
+
+size_t RenderQueue::size() const {
+    return count;
+}
+
+void RenderQueue::submit(RenderState& state, const Frustum& frustum) {
+    std::sort(items, items + count, itemLess);
+
+    for (size_t k = 0; k < count; ++k) {
+        const RenderItem& item = items[k];
+        const Planet& planet = *item.planet;
+        switch (item.pass) {
+        case PASS_OPAQUE:
+            state.enable(GL_LIGHTING, true);
+            state.enable(GL_TEXTURE_2D, item.texture != 0);
+            if (item.texture) {
+                state.bindTexture(item.texture);
+            }
+            planet.drawBody(static_cast<LodLevel>(item.lod));
+            break;
+        case PASS_POINTS:
+            state.enable(GL_LIGHTING, false);
+            state.enable(GL_TEXTURE_2D, false);
+            state.pointSize(item.pointSize);
+            planet.drawPoint();
+            break;
+        case PASS_RINGS:
+            state.enable(GL_LIGHTING, false);
+            state.enable(GL_TEXTURE_2D, true);
+            state.enable(GL_BLEND, true);
+            state.depthMask(false);
+            state.bindTexture(item.texture);
+            planet.drawRings(static_cast<LodLevel>(item.lod));
+            break;
+        case PASS_TRAJECTORIES:
+            state.enable(GL_LIGHTING, false);
+            state.enable(GL_TEXTURE_2D, false);
+            state.enable(GL_BLEND, false);
+            state.depthMask(true);
+            planet.drawTrajectory(frustum);
+            break;
+        }
+        profilerAdd(PROFILE_DRAW_CALLS);
+    }
+
+    // Laisser l'état par défaut attendu par le reste du pipeline fixe
+    state.enable(GL_BLEND, false);
+    state.depthMask(true);
+}
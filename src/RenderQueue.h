@@ -0,0 +1,50 @@
+// RenderQueue.h
+#ifndef RENDER_QUEUE_H
+#define RENDER_QUEUE_H
+
+#include <cstddef>
+#include <GL/glew.h>
+#include "Frustum.h"
+#include "RenderState.h"
+
+class Planet;
+
+// Passes du pipeline fixe, dans l'ordre de soumission
+enum RenderPass {
+    PASS_OPAQUE,      // Sphères éclairées
+    PASS_POINTS,      // Corps lointains, sans éclairage
+    PASS_RINGS,       // Anneaux translucides, sans écriture de profondeur
+    PASS_TRAJECTORIES // Lignes blanches
+};
+
+struct RenderItem {
+    RenderPass pass;
+    GLuint texture;   // 0 : couleur du corps
+    int lod;
+    float pointSize;  // En pixels, pour PASS_POINTS
+    const Planet* planet;
+};
+
+// File de rendu du pipeline fixe : les éléments de tous les corps sont triés par passe,
+// texture puis niveau de détail, de sorte que chaque changement d'état n'a lieu qu'une fois par groupe.
+// Les éléments sont stockés dans frameArena() et ne valent que pour l'image en cours.
+class RenderQueue {
+public:
+    RenderQueue();
+
+    void begin(size_t capacity); // Vide la file et réserve capacity éléments dans l'arène
+    void push(const RenderItem& item); // Au plus capacity éléments depuis begin()
+    size_t size() const;
+
+    // Trie puis dessine ; les changements d'état passent par le cache. Les trajectoires ne
+    // sont tracées que pour leurs morceaux dans frustum.
+    void submit(RenderState& state, const Frustum& frustum);
+
+private:
+    static bool itemLess(const RenderItem& a, const RenderItem& b);
+
+    RenderItem* items;
+    size_t count, capacity;
+};
+
+#endif // RENDER_QUEUE_H
@@ -0,0 +1,151 @@
+// RenderSnapshot.cpp
+#include "RenderSnapshot.h"
+#include "Profiler.h"
+#include "View.h"
+#include <algorithm>
+#include <limits>
+
+void captureSnapshot(const std::vector<Planet>& planets, double simulationTime, long long step,
+                     RenderSnapshot& snapshot) {
+    snapshot.bodies.resize(planets.size());
+    for (size_t k = 0; k < planets.size(); ++k) {
+        const Planet& p = planets[k];
+        BodySnapshot& b = snapshot.bodies[k];
+        b.x = p.x;
+        b.y = p.y;
+        b.z = p.z;
+        b.radius = p.radius;
+        b.rotationAngle = p.rotationAngle;
+        b.id = p.id;
+    }
+    snapshot.simulationTime = simulationTime;
+    snapshot.step = step;
+}
+
+static bool sameBodies(const RenderSnapshot& snapshot, const std::vector<Planet>& bodies) {
+    if (snapshot.bodies.size() != bodies.size()) {
+        return false;
+    }
+    for (size_t k = 0; k < bodies.size(); ++k) {
+        if (snapshot.bodies[k].id != bodies[k].id) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Réordonne les copies dans l'ordre de l'instantané et déplace le focus de la caméra
+static void matchBodies(const RenderSnapshot& snapshot, std::vector<Planet>& bodies) {
+    unsigned int maxId = 0;
+    for (const auto& p : bodies) {
+        maxId = std::max(maxId, p.id);
+    }
+    std::vector<int> oldIndex(maxId + 1, -1);
+    for (size_t k = 0; k < bodies.size(); ++k) {
+        oldIndex[bodies[k].id] = static_cast<int>(k);
+    }
+
+    // Les fusions ne créent pas de corps : chaque identifiant de l'instantané a déjà sa copie
+    std::vector<int> remap(bodies.size(), -1);
+    std::vector<Planet> matched;
+    matched.reserve(snapshot.bodies.size());
+    for (size_t k = 0; k < snapshot.bodies.size(); ++k) {
+        unsigned int id = snapshot.bodies[k].id;
+        int from = id <= maxId ? oldIndex[id] : -1;
+        if (from < 0) {
+            continue; // Ne devrait pas arriver ; le corps n'a pas de texture à reprendre
+        }
+        remap[from] = static_cast<int>(matched.size());
+        matched.push_back(std::move(bodies[from]));
+    }
+
+    // Corps absorbés : vers le survivant le plus proche de leur dernière position affichée
+    for (size_t k = 0; k < remap.size(); ++k) {
+        if (remap[k] >= 0 || matched.empty()) {
+            continue;
+        }
+        const Planet& lost = bodies[k];
+        double best = std::numeric_limits<double>::infinity();
+        for (size_t j = 0; j < matched.size(); ++j) {
+            double dx = matched[j].x - lost.x, dy = matched[j].y - lost.y, dz = matched[j].z - lost.z;
+            double d2 = dx * dx + dy * dy + dz * dz;
+            if (d2 < best) {
+                best = d2;
+                remap[k] = static_cast<int>(j);
+            }
+        }
+    }
+    bodies.swap(matched);
+    remapPlanetFocus(remap);
+}
+
+void applySnapshot(const RenderSnapshot& snapshot, bool fresh, std::vector<Planet>& bodies) {
+    if (snapshot.bodies.empty()) {
+        return; // Rien de publié encore : les copies gardent l'état initial
+    }
+    if (!sameBodies(snapshot, bodies)) {
+        matchBodies(snapshot, bodies);
+    }
+    for (size_t k = 0; k < bodies.size(); ++k) {
+        const BodySnapshot& b = snapshot.bodies[k];
+        Planet& p = bodies[k];
+        p.x = b.x;
+        p.y = b.y;
+        p.z = b.z;
+        p.radius = b.radius;
+        p.rotationAngle = b.rotationAngle;
+        if (fresh) {
+            p.appendTrajectory();
+        }
+    }
+}
+
+SnapshotBuffer::SnapshotBuffer() : middle(1), writeIndex(0), readIndex(2), untaken(0), producerWaiting(false), closed(false) {}
+
+RenderSnapshot& SnapshotBuffer::writeBuffer() {
+    return slots[writeIndex];
+}
+
+void SnapshotBuffer::publish(int maxAhead) {
+    // Le tampon écrit devient le publié ; l'ancien publié devient le tampon d'écriture
+    unsigned int previous = middle.exchange(writeIndex | FRESH, std::memory_order_acq_rel);
+    if (previous & FRESH) {
+        profilerAdd(PROFILE_SNAPSHOTS_DROPPED);
+        ++untaken;
+    } else {
+        untaken = 1;
+    }
+    writeIndex = previous & ~FRESH;
+
+    if (maxAhead > 0 && untaken >= maxAhead) {
+        // Le drapeau est levé avant de relire middle (ordre séquentiel, comme dans acquire) : soit
+        // le rendu le voit et réveille, soit sa prise est visible ici et il n'y a pas d'attente
+        producerWaiting.store(true);
+        std::unique_lock<std::mutex> lock(mutex);
+        taken.wait(lock, [this] { return closed || !(middle.load() & FRESH); });
+        producerWaiting.store(false, std::memory_order_relaxed);
+    }
+}
+
+void SnapshotBuffer::close() {
+    std::lock_guard<std::mutex> lock(mutex);
+    closed = true;
+    taken.notify_all();
+}
+
+const RenderSnapshot& SnapshotBuffer::acquire(bool& fresh) {
+    fresh = (middle.load(std::memory_order_acquire) & FRESH) != 0;
+    if (fresh) {
+        unsigned int published = middle.exchange(readIndex);
+        readIndex = published & ~FRESH;
+        if (producerWaiting.load()) {
+            {
+                std::lock_guard<std::mutex> lock(mutex); // Pas de réveil perdu entre le test et l'attente
+            }
+            taken.notify_one();
+        }
+    } else {
+        profilerAdd(PROFILE_SNAPSHOTS_REUSED);
+    }
+    return slots[readIndex];
+}
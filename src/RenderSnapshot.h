@@ -0,0 +1,77 @@
+// RenderSnapshot.h
+#ifndef RENDER_SNAPSHOT_H
+#define RENDER_SNAPSHOT_H
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <vector>
+#include "Planet.h"
+
+// Ce que le rendu lit d'un corps à la fin d'un pas
+struct BodySnapshot {
+    double x, y, z;       // Position (en mètres) ; la tête de la trajectoire en est déduite
+    double radius;        // Change lors des fusions
+    double rotationAngle;
+    unsigned int id;
+};
+
+struct RenderSnapshot {
+    std::vector<BodySnapshot> bodies;
+    double simulationTime;
+    long long step;
+};
+
+// Recopie l'état des corps dans un instantané (sans allocation en régime établi)
+void captureSnapshot(const std::vector<Planet>& planets, double simulationTime, long long step,
+                     RenderSnapshot& snapshot);
+
+// Met à jour les copies dessinées des corps. Si l'instantané est nouveau, la position est
+// ajoutée à leur trajectoire : la trajectoire dessinée suit les états affichés. Quand le
+// tableau a changé (fusions, rangement de Morton), les copies sont réordonnées d'après les
+// identifiants et la caméra suit son corps ; si celui-ci a été absorbé, elle passe au corps
+// le plus proche de sa dernière position.
+void applySnapshot(const RenderSnapshot& snapshot, bool fresh, std::vector<Planet>& bodies);
+
+// Triple tampon entre un producteur (le thread du pas) et un consommateur (le rendu) : chacun
+// possède un tampon, le troisième est l'état publié le plus récent. Publier ou prendre un état
+// est un seul échange atomique ; le consommateur n'attend jamais. Le producteur peut se caler
+// sur le rendu : après maxAhead publications sans prise, il dort sur une variable de condition
+// jusqu'à ce que le rendu prenne la dernière. Il le signale par producerWaiting, et le rendu ne
+// prend le verrou pour le réveiller que dans ce cas.
+// Un état publié puis remplacé avant d'avoir été pris est perdu (compteur snapshots_dropped) :
+// sans limite, chaque pas de plus qu'une image ; avec maxAhead, maxAhead - 1 états par image au
+// plus, donc aucun pour maxAhead = 1. Une image sans nouvel état redessine le précédent
+// (snapshots_reused).
+class SnapshotBuffer {
+public:
+    SnapshotBuffer();
+
+    // Producteur : tampon à remplir, puis publication. maxAhead : états publiés au plus sans
+    // que le rendu en prenne un (0 : aucune attente).
+    RenderSnapshot& writeBuffer();
+    void publish(int maxAhead = 0);
+
+    // Fin du rendu : libère le producteur en attente, et toute attente ultérieure
+    void close();
+
+    // Consommateur : l'état le plus récent ; fresh indique s'il n'avait pas encore été pris.
+    // Avant toute publication, l'instantané rendu est vide.
+    const RenderSnapshot& acquire(bool& fresh);
+
+private:
+    static const unsigned int FRESH = 4; // Bit ajouté à l'indice du tampon publié
+
+    RenderSnapshot slots[3];
+    std::atomic<unsigned int> middle; // Tampon publié, et FRESH s'il n'a pas été pris
+    unsigned int writeIndex;          // Propriété du producteur
+    unsigned int readIndex;           // Propriété du consommateur
+    int untaken;                      // Publications depuis la dernière prise (producteur)
+
+    std::atomic<bool> producerWaiting; // Le producteur dort (ou va dormir) sur taken
+    std::mutex mutex;
+    std::condition_variable taken;
+    bool closed;
+};
+
+#endif // RENDER_SNAPSHOT_H
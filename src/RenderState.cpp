@@ -0,0 +1,88 @@
+// RenderState.cpp
+#include "RenderState.h"
+#include "Profiler.h"
+
+const GLenum RenderState::capabilities[RenderState::CAPABILITY_COUNT] = {
+    GL_LIGHTING, GL_TEXTURE_2D, GL_BLEND, GL_DEPTH_TEST
+};
+
+RenderState::RenderState() {
+    invalidate();
+}
+
+void RenderState::invalidate() {
+    for (int c = 0; c < CAPABILITY_COUNT; ++c) {
+        enabled[c] = -1;
+    }
+    depthWrite = -1;
+    size = -1.0f;
+    texture = program = vao = 0;
+    textureKnown = programKnown = vaoKnown = false;
+}
+
+void RenderState::enable(GLenum capability, bool on) {
+    int c = 0;
+    while (c < CAPABILITY_COUNT && capabilities[c] != capability) {
+        ++c;
+    }
+    if (c < CAPABILITY_COUNT) {
+        if (enabled[c] == (on ? 1 : 0)) {
+            return;
+        }
+        enabled[c] = on ? 1 : 0;
+    }
+    if (on) {
+        glEnable(capability);
+    } else {
+        glDisable(capability);
+    }
+    profilerAdd(PROFILE_STATE_CHANGES);
+}
+
+void RenderState::bindTexture(GLuint name) {
+    if (textureKnown && texture == name) {
+        return;
+    }
+    glBindTexture(GL_TEXTURE_2D, name);
+    texture = name;
+    textureKnown = true;
+    profilerAdd(PROFILE_STATE_CHANGES);
+}
+
+void RenderState::depthMask(bool on) {
+    if (depthWrite == (on ? 1 : 0)) {
+        return;
+    }
+    glDepthMask(on ? GL_TRUE : GL_FALSE);
+    depthWrite = on ? 1 : 0;
+    profilerAdd(PROFILE_STATE_CHANGES);
+}
+
+void RenderState::pointSize(float value) {
+    if (size == value) {
+        return;
+    }
+    glPointSize(value);
+    size = value;
+    profilerAdd(PROFILE_STATE_CHANGES);
+}
+
+void RenderState::useProgram(GLuint name) {
+    if (programKnown && program == name) {
+        return;
+    }
+    glUseProgram(name);
+    program = name;
+    programKnown = true;
+    profilerAdd(PROFILE_STATE_CHANGES);
+}
+
+void RenderState::bindVertexArray(GLuint name) {
+    if (vaoKnown && vao == name) {
+        return;
+    }
+    glBindVertexArray(name);
+    vao = name;
+    vaoKnown = true;
+    profilerAdd(PROFILE_STATE_CHANGES);
+}
@@ -0,0 +1,34 @@
+// RenderState.h
+#ifndef RENDER_STATE_H
+#define RENDER_STATE_H
+
+#include <GL/glew.h>
+
+// Cache de l'état OpenGL : un appel n'est transmis au pilote que si la valeur change,
+// et chaque changement effectif est compté dans le profiler (PROFILE_STATE_CHANGES).
+class RenderState {
+public:
+    RenderState();
+
+    // L'état réel est inconnu (début d'image, code extérieur) : le prochain appel de chaque type passe
+    void invalidate();
+
+    void enable(GLenum capability, bool on); // GL_LIGHTING, GL_TEXTURE_2D, GL_BLEND, GL_DEPTH_TEST
+    void bindTexture(GLuint texture);         // GL_TEXTURE_2D, unité courante
+    void depthMask(bool on);
+    void pointSize(float size);
+    void useProgram(GLuint program);
+    void bindVertexArray(GLuint vao);
+
+private:
+    static const int CAPABILITY_COUNT = 4;
+    static const GLenum capabilities[CAPABILITY_COUNT];
+
+    int enabled[CAPABILITY_COUNT]; // -1 = inconnu
+    int depthWrite;
+    float size;
+    GLuint texture, program, vao;
+    bool textureKnown, programKnown, vaoKnown;
+};
+
+#endif // RENDER_STATE_H
@@ -0,0 +1,130 @@
+// ResolutionScaler.cpp
+#include "ResolutionScaler.h"
+#include "Profiler.h"
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+ResolutionScaler::ResolutionScaler()
+    : budget(0.0), minScale(1.0), currentScale(1.0), smoothed(0.0), fbo(0), colorBuffer(0), depthBuffer(0),
+      issued(0), width(0), height(0), renderWidth(0), renderHeight(0) {
+    for (int k = 0; k < QUERY_COUNT; ++k) {
+        queries[k] = 0;
+    }
+}
+
+bool ResolutionScaler::init(double budgetMs, double minimum) {
+    if (!GLEW_VERSION_3_3 && !GLEW_ARB_timer_query) {
+        std::cerr << "Dynamic resolution needs timer queries (OpenGL 3.3 or ARB_timer_query)" << std::endl;
+        return false;
+    }
+    budget = budgetMs;
+    minScale = minimum;
+    currentScale = 1.0;
+    smoothed = 0.0;
+    issued = 0;
+    glGenFramebuffers(1, &fbo);
+    glGenRenderbuffers(1, &colorBuffer);
+    glGenRenderbuffers(1, &depthBuffer);
+    glGenQueries(QUERY_COUNT, queries);
+    return true;
+}
+
+bool ResolutionScaler::active() const {
+    return fbo != 0;
+}
+
+double ResolutionScaler::scale() const {
+    return currentScale;
+}
+
+bool ResolutionScaler::allocate(int w, int h) {
+    glBindRenderbuffer(GL_RENDERBUFFER, colorBuffer);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_RGBA8, w, h);
+    glBindRenderbuffer(GL_RENDERBUFFER, depthBuffer);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT24, w, h);
+    glBindRenderbuffer(GL_RENDERBUFFER, 0);
+    glBindFramebuffer(GL_FRAMEBUFFER, fbo);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, colorBuffer);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_RENDERBUFFER, depthBuffer);
+    GLenum status = glCheckFramebufferStatus(GL_FRAMEBUFFER);
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    if (status != GL_FRAMEBUFFER_COMPLETE) {
+        std::cerr << "Failed to create scaled framebuffer (status 0x" << std::hex << status << std::dec << ")" << std::endl;
+        return false;
+    }
+    width = w;
+    height = h;
+    return true;
+}
+
+void ResolutionScaler::beginFrame(int windowWidth, int windowHeight) {
+    renderWidth = renderHeight = 0;
+    if (windowWidth <= 0 || windowHeight <= 0) {
+        return; // Fenêtre réduite : rien à mesurer
+    }
+    // Le FBO garde la taille de la fenêtre : changer d'échelle ne change que le viewport
+    if ((windowWidth != width || windowHeight != height) && !allocate(windowWidth, windowHeight)) {
+        width = height = 0;
+        glViewport(0, 0, windowWidth, windowHeight); // Rendu direct, nouvel essai à l'image suivante
+        return;
+    }
+    renderWidth = std::max(1, static_cast<int>(std::lround(width * currentScale)));
+    renderHeight = std::max(1, static_cast<int>(std::lround(height * currentScale)));
+    glBindFramebuffer(GL_FRAMEBUFFER, fbo);
+    glViewport(0, 0, renderWidth, renderHeight);
+    glBeginQuery(GL_TIME_ELAPSED, queries[issued % QUERY_COUNT]);
+    profilerAdd(PROFILE_RENDER_PIXELS, static_cast<long long>(renderWidth) * renderHeight);
+}
+
+void ResolutionScaler::endFrame() {
+    if (renderWidth == 0) {
+        return;
+    }
+    glEndQuery(GL_TIME_ELAPSED);
+    ++issued;
+
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, fbo);
+    glBindFramebuffer(GL_DRAW_FRAMEBUFFER, 0);
+    glBlitFramebuffer(0, 0, renderWidth, renderHeight, 0, 0, width, height, GL_COLOR_BUFFER_BIT,
+                      renderWidth == width ? GL_NEAREST : GL_LINEAR);
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    glViewport(0, 0, width, height);
+
+    // La requête la plus ancienne de l'anneau, réutilisée à l'image suivante
+    if (issued >= QUERY_COUNT + SCALER_WARMUP_FRAMES) {
+        GLuint query = queries[issued % QUERY_COUNT];
+        GLint available = 0;
+        glGetQueryObjectiv(query, GL_QUERY_RESULT_AVAILABLE, &available);
+        if (available) {
+            GLuint64 nanoseconds = 0;
+            glGetQueryObjectui64v(query, GL_QUERY_RESULT, &nanoseconds);
+            adjust(nanoseconds * 1e-6);
+        }
+    }
+}
+
+void ResolutionScaler::adjust(double gpuMs) {
+    gpuMs = std::min(gpuMs, SCALER_MAX_SAMPLE * budget);
+    smoothed = smoothed > 0.0 ? 0.8 * smoothed + 0.2 * gpuMs : gpuMs;
+    double wanted = currentScale * sqrt(SCALER_HEADROOM * budget / std::max(smoothed, 1e-3));
+    wanted = std::min(std::max(wanted, currentScale * SCALER_STEP_DOWN), currentScale * SCALER_STEP_UP);
+    wanted = std::min(std::max(wanted, minScale), 1.0);
+    if (std::fabs(wanted - currentScale) < SCALER_HYSTERESIS && wanted > minScale && wanted < 1.0) {
+        return; // Les bornes restent atteignables par petits pas
+    }
+    // Les images déjà en vol ont été rendues à l'ancienne échelle : la moyenne est extrapolée
+    smoothed *= (wanted / currentScale) * (wanted / currentScale);
+    currentScale = wanted;
+}
+
+void ResolutionScaler::destroy() {
+    if (fbo) {
+        glDeleteFramebuffers(1, &fbo);
+        glDeleteRenderbuffers(1, &colorBuffer);
+        glDeleteRenderbuffers(1, &depthBuffer);
+        glDeleteQueries(QUERY_COUNT, queries);
+    }
+    fbo = colorBuffer = depthBuffer = 0;
+    width = height = 0;
+}
@@ -0,0 +1,49 @@
+// ResolutionScaler.h
+#ifndef RESOLUTION_SCALER_H
+#define RESOLUTION_SCALER_H
+
+#include <GL/glew.h>
+
+const double SCALER_HEADROOM = 0.85; // Part du budget visée, pour absorber les variations d'une image à l'autre
+const double SCALER_STEP_DOWN = 0.85; // Baisse maximale de l'échelle par image
+const double SCALER_STEP_UP = 1.05;   // Hausse maximale : remonter lentement évite les oscillations
+const double SCALER_HYSTERESIS = 0.02; // Écart d'échelle en dessous duquel rien ne change
+const double SCALER_MAX_SAMPLE = 4.0;  // Mesure bornée à ce multiple du budget : un à-coup isolé ne s'amplifie pas
+const long long SCALER_WARMUP_FRAMES = 8; // Premières images ignorées (compilation des shaders, envoi des textures)
+
+// Résolution dynamique : l'image est rendue dans un FBO à une fraction de la taille du
+// framebuffer de la fenêtre, puis agrandie avec un filtrage linéaire. La fraction suit le
+// temps GPU de l'image, mesuré par des requêtes GL_TIME_ELAPSED relues QUERY_COUNT - 1 images
+// plus tard pour ne jamais attendre le GPU. Le coût du rendu étant à peu près proportionnel au
+// nombre de pixels, l'échelle visée est scale * sqrt(cible / temps mesuré).
+class ResolutionScaler {
+public:
+    ResolutionScaler();
+
+    // budgetMs : temps GPU visé par image ; minScale : fraction minimale de chaque dimension
+    bool init(double budgetMs, double minScale);
+    bool active() const;
+    double scale() const;
+
+    // Lie le FBO (réalloué quand la fenêtre change de taille) avec le viewport réduit
+    void beginFrame(int windowWidth, int windowHeight);
+    // Agrandit l'image dans le framebuffer par défaut, puis ajuste l'échelle
+    void endFrame();
+    void destroy();
+
+private:
+    static const int QUERY_COUNT = 3;
+
+    bool allocate(int w, int h);
+    void adjust(double gpuMs);
+
+    double budget, minScale, currentScale;
+    double smoothed; // Moyenne glissante du temps GPU (ms), 0 avant la première mesure
+    GLuint fbo, colorBuffer, depthBuffer;
+    GLuint queries[QUERY_COUNT];
+    long long issued;
+    int width, height;             // Taille allouée (celle du framebuffer de la fenêtre)
+    int renderWidth, renderHeight; // Partie rendue à cette image (0 : rendu direct)
+};
+
+#endif // RESOLUTION_SCALER_H
@@ -0,0 +1,76 @@
+// RingSystem.cpp
+#include "RingSystem.h"
+#include "Planet.h"
+#include "Texture.h"
+#include <cmath>
+#include <vector>
+
+RingSystem::RingSystem()
+    : innerRadius(0.0), outerRadius(0.0), tilt(0.0), texture(0), vbo(0) {
+    for (int l = 0; l < LOD_POINT; ++l) {
+        first[l] = 0;
+        count[l] = 0;
+    }
+}
+
+bool createRingSystem(RingSystem& rings, double innerRadius, double outerRadius, double tilt, const char* texturePath) {
+    GLuint texture = loadTexture(texturePath);
+    if (!texture) {
+        return false; // Erreur déjà signalée par loadTexture
+    }
+    rings.innerRadius = innerRadius;
+    rings.outerRadius = outerRadius;
+    rings.tilt = tilt;
+    rings.texture = texture;
+
+    // Couronne dans le plan XY (s autour de l'anneau, t de l'intérieur vers l'extérieur), puis inclinée
+    double inner = innerRadius / AU, outer = outerRadius / AU;
+    double cosTilt = cos(tilt), sinTilt = sin(tilt);
+    std::vector<float> vertices;
+    for (int l = 0; l < LOD_POINT; ++l) {
+        int segments = ringSegments(static_cast<LodLevel>(l));
+        rings.first[l] = static_cast<GLint>(vertices.size() / 5);
+        rings.count[l] = 2 * (segments + 1);
+        for (int i = 0; i <= segments; ++i) {
+            double theta = 2.0 * M_PI * i / segments;
+            double c = cos(theta), s = -sin(theta);
+            float u = static_cast<float>(i) / segments;
+            float vInner[5] = { static_cast<float>(inner * c), static_cast<float>(inner * s * cosTilt),
+                                static_cast<float>(inner * s * sinTilt), u, 0.0f };
+            float vOuter[5] = { static_cast<float>(outer * c), static_cast<float>(outer * s * cosTilt),
+                                static_cast<float>(outer * s * sinTilt), u, 1.0f };
+            vertices.insert(vertices.end(), vInner, vInner + 5);
+            vertices.insert(vertices.end(), vOuter, vOuter + 5);
+        }
+    }
+
+    glGenBuffers(1, &rings.vbo);
+    glBindBuffer(GL_ARRAY_BUFFER, rings.vbo);
+    glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(float), vertices.data(), GL_STATIC_DRAW);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    return true;
+}
+
+void destroyRingSystem(RingSystem& rings) {
+    glDeleteBuffers(1, &rings.vbo);
+    glDeleteTextures(1, &rings.texture);
+    rings.vbo = 0;
+    rings.texture = 0;
+}
+
+void drawRingSystem(const RingSystem& rings, LodLevel level) {
+    if (!rings.present() || level >= LOD_POINT) {
+        return;
+    }
+    glColor4f(1.0f, 1.0f, 1.0f, 1.0f);
+
+    glBindBuffer(GL_ARRAY_BUFFER, rings.vbo);
+    glEnableClientState(GL_VERTEX_ARRAY);
+    glEnableClientState(GL_TEXTURE_COORD_ARRAY);
+    glVertexPointer(3, GL_FLOAT, RING_VERTEX_STRIDE, nullptr);
+    glTexCoordPointer(2, GL_FLOAT, RING_VERTEX_STRIDE, reinterpret_cast<void*>(RING_TEXCOORD_OFFSET));
+    glDrawArrays(GL_TRIANGLE_STRIP, rings.first[level], rings.count[level]);
+    glDisableClientState(GL_TEXTURE_COORD_ARRAY);
+    glDisableClientState(GL_VERTEX_ARRAY);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
@@ -0,0 +1,36 @@
+// RingSystem.h
+#ifndef RING_SYSTEM_H
+#define RING_SYSTEM_H
+
+#include <cstddef>
+#include <GL/glew.h>
+#include "Lod.h"
+
+// Anneaux d'un corps : couronne plane centrée sur le corps, inclinée autour de l'axe X.
+// Tous les niveaux de détail sont construits une seule fois dans un VBO statique
+// (positions en unités astronomiques relatives au centre du corps, puis coordonnées de texture),
+// il n'y a donc plus de trigonométrie par image.
+struct RingSystem {
+    double innerRadius, outerRadius; // En mètres
+    double tilt;                     // Inclinaison du plan des anneaux sur le plan XY (radians)
+    GLuint texture;
+    GLuint vbo;                      // 0 si le corps n'a pas d'anneaux
+    GLint first[LOD_POINT];          // Premier sommet du triangle strip de chaque niveau
+    GLsizei count[LOD_POINT];        // Nombre de sommets de chaque niveau
+
+    RingSystem();
+    bool present() const { return vbo != 0; }
+};
+
+const GLsizei RING_VERTEX_STRIDE = 5 * sizeof(float); // x, y, z, s, t
+const size_t RING_TEXCOORD_OFFSET = 3 * sizeof(float);
+
+// Construit le maillage et charge la texture (contexte OpenGL requis) ; false si la texture manque
+bool createRingSystem(RingSystem& rings, double innerRadius, double outerRadius, double tilt, const char* texturePath);
+void destroyRingSystem(RingSystem& rings);
+
+// Pipeline fixe : un seul appel de dessin, la matrice courante doit être centrée sur le corps.
+// La texture et le mélange sont positionnés par l'appelant (file de rendu).
+void drawRingSystem(const RingSystem& rings, LodLevel level);
+
+#endif // RING_SYSTEM_H
@@ -0,0 +1,222 @@
+// Scheduler.cpp
+#include "Scheduler.h"
+#include "Numa.h"
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+namespace {
+
+struct Job {
+    std::function<void()> work;
+    std::atomic<int>* pending;
+};
+
+struct WorkerQueue {
+    std::mutex mutex;
+    std::deque<Job> jobs;
+};
+
+const int MAX_WORKERS = 255;
+
+// Files préallouées : les voleurs les parcourent sans verrou global pendant que le groupe grandit
+struct SchedulerState {
+    WorkerQueue queues[MAX_WORKERS + 1]; // 0 : threads hors du groupe
+    std::vector<std::thread> threads;
+    std::mutex reserveMutex;
+    std::mutex sleepMutex;
+    std::condition_variable wake;
+    std::atomic<int> workerCount;
+    std::atomic<int> queued;
+    std::atomic<bool> stopping;
+    bool pinned;
+
+    SchedulerState() : workerCount(0), queued(0), stopping(false), pinned(false) {}
+    ~SchedulerState() { schedulerShutdown(); }
+};
+
+SchedulerState state;
+thread_local int currentQueue = 0;
+
+bool popLocal(int self, Job& job) {
+    WorkerQueue& queue = state.queues[self];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    if (queue.jobs.empty()) {
+        return false;
+    }
+    job = std::move(queue.jobs.back());
+    queue.jobs.pop_back();
+    return true;
+}
+
+bool steal(int self, Job& job) {
+    int count = state.workerCount.load(std::memory_order_acquire) + 1;
+    for (int k = 1; k < count; ++k) {
+        WorkerQueue& queue = state.queues[(self + k) % count];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (!queue.jobs.empty()) {
+            job = std::move(queue.jobs.front());
+            queue.jobs.pop_front();
+            return true;
+        }
+    }
+    return false;
+}
+
+bool runOne(int self) {
+    Job job;
+    if (!popLocal(self, job) && !steal(self, job)) {
+        return false;
+    }
+    state.queued.fetch_sub(1, std::memory_order_relaxed);
+    job.work();
+    if (job.pending) {
+        job.pending->fetch_sub(1, std::memory_order_acq_rel);
+    }
+    return true;
+}
+
+void workerLoop(int index, bool pin) {
+    currentQueue = index;
+    if (pin) {
+        pinCurrentThread(numaCpuForThread(index));
+    }
+    while (!state.stopping.load(std::memory_order_acquire)) {
+        if (runOne(index)) {
+            continue;
+        }
+        std::unique_lock<std::mutex> lock(state.sleepMutex);
+        state.wake.wait(lock, [] { return state.queued.load() > 0 || state.stopping.load(); });
+    }
+}
+
+} // namespace
+
+void schedulerReserve(int workers) {
+    if (workers > MAX_WORKERS) {
+        workers = MAX_WORKERS;
+    }
+    if (state.workerCount.load(std::memory_order_acquire) >= workers) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(state.reserveMutex);
+    while (static_cast<int>(state.threads.size()) < workers) {
+        int index = static_cast<int>(state.threads.size()) + 1;
+        state.threads.emplace_back(workerLoop, index, state.pinned);
+        state.workerCount.store(index, std::memory_order_release);
+    }
+}
+
+void schedulerSubmit(const std::function<void()>& work, std::atomic<int>* pending) {
+    schedulerSubmitTo(currentQueue, work, pending);
+}
+
+void schedulerSubmitTo(int worker, const std::function<void()>& work, std::atomic<int>* pending) {
+    if (worker < 0 || worker > state.workerCount.load(std::memory_order_acquire)) {
+        worker = currentQueue;
+    }
+    WorkerQueue& queue = state.queues[worker];
+    {
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        Job job = { work, pending };
+        queue.jobs.push_back(std::move(job));
+    }
+    state.queued.fetch_add(1, std::memory_order_relaxed);
+    {
+        std::lock_guard<std::mutex> lock(state.sleepMutex); // Pas de réveil perdu entre le test et l'attente
+    }
+    state.wake.notify_one();
+}
+
+void schedulerWait(std::atomic<int>& pending) {
+    while (pending.load(std::memory_order_acquire) > 0) {
+        if (!runOne(currentQueue)) {
+            std::this_thread::yield();
+        }
+    }
+}
+
+void schedulerShutdown() {
+    std::lock_guard<std::mutex> lock(state.reserveMutex);
+    {
+        std::lock_guard<std::mutex> sleepLock(state.sleepMutex);
+        state.stopping.store(true, std::memory_order_release);
+    }
+    state.wake.notify_all();
+    for (auto& thread : state.threads) {
+        thread.join();
+    }
+    state.threads.clear();
+    state.workerCount.store(0, std::memory_order_release);
+    state.stopping.store(false, std::memory_order_release);
+}
+
+void schedulerPinThreads(bool pin) {
+    schedulerShutdown();
+    std::lock_guard<std::mutex> lock(state.reserveMutex);
+    state.pinned = pin;
+    if (pin) {
+        pinCurrentThread(numaCpuForThread(0));
+    } else {
+        unpinCurrentThread();
+    }
+}
+
+TaskGraph::TaskGraph() : pendingSize(0), remaining(0) {}
+
+TaskGraph::TaskId TaskGraph::add(const std::function<void()>& work) {
+    Node node;
+    node.work = work;
+    node.dependencies = 0;
+    nodes.push_back(std::move(node));
+    return nodes.size() - 1;
+}
+
+void TaskGraph::precede(TaskId before, TaskId after) {
+    nodes[before].successors.push_back(after);
+    ++nodes[after].dependencies;
+}
+
+size_t TaskGraph::size() const {
+    return nodes.size();
+}
+
+void TaskGraph::submit(TaskId id) {
+    schedulerSubmit([this, id] {
+        Node& node = nodes[id];
+        node.work();
+        for (TaskId next : node.successors) {
+            if (pending[next].fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                submit(next);
+            }
+        }
+    }, &remaining);
+}
+
+void TaskGraph::run(int threads) {
+    if (nodes.empty()) {
+        return;
+    }
+    if (threads > 1) {
+        schedulerReserve(threads - 1);
+    }
+    if (pendingSize < nodes.size()) {
+        pending.reset(new std::atomic<int>[nodes.size()]);
+        pendingSize = nodes.size();
+    }
+    for (size_t k = 0; k < nodes.size(); ++k) {
+        pending[k].store(nodes[k].dependencies, std::memory_order_relaxed);
+    }
+    remaining.store(static_cast<int>(nodes.size()), std::memory_order_release);
+    for (size_t k = 0; k < nodes.size(); ++k) {
+        if (nodes[k].dependencies == 0) {
+            submit(k);
+        }
+    }
+    schedulerWait(remaining);
+}
+
+void TaskGraph::clear() {
+    nodes.clear();
+}
@@ -0,0 +1,70 @@
+// Scheduler.h
+#ifndef SCHEDULER_H
+#define SCHEDULER_H
+
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <vector>
+
+// Ordonnanceur à vol de tâches : un groupe de threads persistants, chacun avec sa file.
+// Un thread dépile ses propres tâches par la fin (les plus récentes, encore en cache) et,
+// quand sa file est vide, en vole par le début de celle d'un autre. Les threads hors du
+// groupe (le thread principal) partagent la file 0. Un thread qui attend exécute des
+// tâches au lieu de dormir : les appels imbriqués ne peuvent pas bloquer le groupe.
+
+// Garantit au moins workers threads dans le groupe (en plus de l'appelant)
+void schedulerReserve(int workers);
+
+// Ajoute une tâche ; pending est décrémenté quand elle se termine
+void schedulerSubmit(const std::function<void()>& work, std::atomic<int>* pending);
+
+// Ajoute une tâche dans la file d'un thread donné (0 : thread principal) : elle y sera prise
+// en priorité, mais reste volable si ce thread est occupé
+void schedulerSubmitTo(int worker, const std::function<void()>& work, std::atomic<int>* pending);
+
+// Fixe chaque thread du groupe sur un CPU, nœud NUMA par nœud (voir numaCpuForThread) ;
+// l'appelant prend la place 0. Le groupe existant est arrêté et sera recréé à la demande.
+// pin = false rend à l'appelant son affinité d'origine ; les threads recréés sont libres.
+void schedulerPinThreads(bool pin);
+
+// Exécute des tâches jusqu'à ce que pending tombe à zéro
+void schedulerWait(std::atomic<int>& pending);
+
+// Arrête et rejoint les threads du groupe (fin de programme)
+void schedulerShutdown();
+
+// Graphe de tâches : une tâche est soumise dès que toutes celles qui la précèdent sont terminées,
+// si bien que les étapes indépendantes se recouvrent et qu'une étape déséquilibrée découpée en
+// nombreuses tâches est répartie par le vol de tâches.
+class TaskGraph {
+public:
+    typedef size_t TaskId;
+
+    TaskGraph();
+
+    TaskId add(const std::function<void()>& work);
+    void precede(TaskId before, TaskId after); // after attend la fin de before
+    size_t size() const;
+
+    // Exécute tout le graphe avec threads threads au total (appelant compris) et attend la fin
+    void run(int threads);
+    void clear();
+
+private:
+    struct Node {
+        std::function<void()> work;
+        std::vector<TaskId> successors;
+        int dependencies;
+    };
+
+    void submit(TaskId id);
+
+    std::vector<Node> nodes;
+    std::unique_ptr<std::atomic<int>[]> pending; // Prédécesseurs restants de chaque tâche pendant run()
+    size_t pendingSize;
+    std::atomic<int> remaining;
+};
+
+#endif // SCHEDULER_H
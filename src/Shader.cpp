@@ -0,0 +1,54 @@
+// Shader.cpp
+#include "Shader.h"
+#include <iostream>
+#include <vector>
+
+static GLuint compileShader(GLenum type, const char* source, const char* name) {
+    GLuint shader = glCreateShader(type);
+    glShaderSource(shader, 1, &source, nullptr);
+    glCompileShader(shader);
+
+    GLint status = GL_FALSE;
+    glGetShaderiv(shader, GL_COMPILE_STATUS, &status);
+    if (status != GL_TRUE) {
+        GLint length = 0;
+        glGetShaderiv(shader, GL_INFO_LOG_LENGTH, &length);
+        std::vector<char> log(length > 1 ? length : 1, '\0');
+        glGetShaderInfoLog(shader, static_cast<GLsizei>(log.size()), nullptr, log.data());
+        std::cerr << "Failed to compile " << (type == GL_VERTEX_SHADER ? "vertex" : "fragment")
+                  << " shader " << name << ":\n" << log.data() << std::endl;
+        glDeleteShader(shader);
+        return 0;
+    }
+    return shader;
+}
+
+GLuint createProgram(const char* vertexSource, const char* fragmentSource, const char* name) {
+    GLuint vertex = compileShader(GL_VERTEX_SHADER, vertexSource, name);
+    GLuint fragment = compileShader(GL_FRAGMENT_SHADER, fragmentSource, name);
+    if (!vertex || !fragment) {
+        glDeleteShader(vertex);
+        glDeleteShader(fragment);
+        return 0;
+    }
+
+    GLuint program = glCreateProgram();
+    glAttachShader(program, vertex);
+    glAttachShader(program, fragment);
+    glLinkProgram(program);
+    glDeleteShader(vertex); // Détachés et libérés avec le programme
+    glDeleteShader(fragment);
+
+    GLint status = GL_FALSE;
+    glGetProgramiv(program, GL_LINK_STATUS, &status);
+    if (status != GL_TRUE) {
+        GLint length = 0;
+        glGetProgramiv(program, GL_INFO_LOG_LENGTH, &length);
+        std::vector<char> log(length > 1 ? length : 1, '\0');
+        glGetProgramInfoLog(program, static_cast<GLsizei>(log.size()), nullptr, log.data());
+        std::cerr << "Failed to link program " << name << ":\n" << log.data() << std::endl;
+        glDeleteProgram(program);
+        return 0;
+    }
+    return program;
+}
@@ -0,0 +1,10 @@
+// Shader.h
+#ifndef SHADER_H
+#define SHADER_H
+
+#include <GL/glew.h>
+
+// Compile et lie un programme ; retourne 0 et affiche le journal du pilote en cas d'échec
+GLuint createProgram(const char* vertexSource, const char* fragmentSource, const char* name);
+
+#endif // SHADER_H
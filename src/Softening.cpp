@@ -0,0 +1,12 @@
+// Softening.cpp
+#include "Softening.h"
+
+static SofteningKernel kernelInUse = SOFTENING_CLAMP;
+
+void setSofteningKernel(SofteningKernel kernel) {
+    kernelInUse = kernel;
+}
+
+SofteningKernel softeningKernel() {
+    return kernelInUse;
+}
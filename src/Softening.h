@@ -0,0 +1,71 @@
+// Softening.h
+#ifndef SOFTENING_H
+#define SOFTENING_H
+
+#include <cmath>
+
+enum SofteningKernel {
+    SOFTENING_CLAMP,   // Distance bornée à la longueur d'adoucissement (loi historique, force discontinue)
+    SOFTENING_PLUMMER, // Potentiel de Plummer : -G m / sqrt(r² + ε²)
+    SOFTENING_SPLINE   // Spline cubique de Monaghan : exactement newtonien au-delà de SPLINE_SUPPORT * ε
+};
+
+const double SOFTENING_DEFAULT_LENGTH = 1e3; // Longueur d'adoucissement par défaut (en mètres)
+const double SPLINE_SUPPORT = 2.8; // Rayon du noyau spline en longueurs ε : même potentiel central que Plummer
+
+// Noyau commun à toutes les forces (paires directes, Barnes-Hut, passe à courte portée, ensembles,
+// mode distribué). À choisir avant le premier pas : les boucles de force le lisent une fois.
+void setSofteningKernel(SofteningKernel kernel);
+SofteningKernel softeningKernel();
+
+// Longueur d'une paire : la plus grande des deux. Symétrique, pour que les forces d'une paire
+// restent opposées ; un nœud de Barnes-Hut prend de même la plus grande de ses corps.
+inline double pairSoftening(double a, double b) {
+    return a > b ? a : b;
+}
+
+// f tel que l'accélération due à une masse m soit G m f (dx, dy, dz), avec r2 = dx² + dy² + dz² ;
+// f = 1 / r³ hors du noyau
+inline double softenedForceFactor(SofteningKernel kernel, double r2, double epsilon) {
+    if (kernel == SOFTENING_PLUMMER) {
+        double s2 = r2 + epsilon * epsilon;
+        return 1.0 / (s2 * sqrt(s2));
+    }
+    double r = sqrt(r2);
+    if (kernel == SOFTENING_CLAMP) {
+        r = r < epsilon ? epsilon : r;
+        return 1.0 / (r * r * r);
+    }
+    double h = SPLINE_SUPPORT * epsilon;
+    if (r >= h) {
+        return 1.0 / (r2 * r);
+    }
+    double u = r / h;
+    double h3 = 1.0 / (h * h * h);
+    if (u < 0.5) {
+        return h3 * (10.666666666667 + u * u * (32.0 * u - 38.4));
+    }
+    return h3 * (21.333333333333 - 48.0 * u + 38.4 * u * u - 10.666666666667 * u * u * u - 0.066666666667 / (u * u * u));
+}
+
+// g tel que l'énergie potentielle d'une paire soit -G m1 m2 g ; g = 1 / r hors du noyau
+inline double softenedPotential(SofteningKernel kernel, double r2, double epsilon) {
+    if (kernel == SOFTENING_PLUMMER) {
+        return 1.0 / sqrt(r2 + epsilon * epsilon);
+    }
+    double r = sqrt(r2);
+    if (kernel == SOFTENING_CLAMP) {
+        return 1.0 / (r < epsilon ? epsilon : r);
+    }
+    double h = SPLINE_SUPPORT * epsilon;
+    if (r >= h) {
+        return 1.0 / r;
+    }
+    double u = r / h;
+    if (u < 0.5) {
+        return (2.8 - u * u * (5.333333333333 + u * u * (6.4 * u - 9.6))) / h;
+    }
+    return (3.2 - 0.066666666667 / u - u * u * (10.666666666667 + u * (-16.0 + u * (9.6 - 2.133333333333 * u)))) / h;
+}
+
+#endif // SOFTENING_H
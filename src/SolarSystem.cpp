@@ -0,0 +1,84 @@
+// SolarSystem.cpp
+#include "SolarSystem.h"
+#include <cmath>
+#include <random>
+
+const std::vector<BodyDefinition>& solarSystemDefinition() {
+    static const std::vector<BodyDefinition> bodies = {
+        { "Sun",     -1, 0.0,            696340000.0, SUN_MASS,   1.0f, 1.0f, 0.0f, "textures/sun.jpeg",     2 * M_PI / (25 * DAY),   nullptr,                    0.0,         0.0,         0.0 },
+        { "Mercury",  0, 0.39 * AU,      2439700.0,   3.3011e23,  0.5f, 0.5f, 0.5f, "textures/mercury.jpg", 2 * M_PI / (58.6 * DAY), nullptr,                    0.0,         0.0,         0.0 },
+        { "Venus",    0, 0.72 * AU,      6051800.0,   4.8675e24,  1.0f, 0.5f, 0.0f, "textures/venus.jpg",    -2 * M_PI / (243 * DAY), nullptr,                    0.0,         0.0,         0.0 },
+        { "Earth",    0, AU,             6371000.0,   5.972e24,   0.0f, 0.0f, 1.0f, "textures/earth.jpeg",   2 * M_PI / DAY,          nullptr,                    0.0,         0.0,         0.0 },
+        { "Moon",     3, 384400 * 1000,  1737100.0,   7.347e22,   1.0f, 1.0f, 1.0f, "textures/moon.jpeg",    2 * M_PI / (27.3 * DAY), nullptr,                    0.0,         0.0,         0.0 },
+        { "Mars",     0, 1.524 * AU,     3389500.0,   6.39e23,    1.0f, 0.0f, 0.0f, "textures/mars.jpeg",    2 * M_PI / (1.03 * DAY), nullptr,                    0.0,         0.0,         0.0 },
+        { "Jupiter",  0, 5.2 * AU,       69911000.0,  1.8982e27,  1.0f, 0.5f, 0.0f, "textures/jupiter.jpeg", 2 * M_PI / (0.41 * DAY), nullptr,                    0.0,         0.0,         0.0 },
+        { "Saturn",   0, 9.58 * AU,      58232000.0,  5.6834e26,  1.0f, 1.0f, 0.5f, "textures/saturn.jpeg",  2 * M_PI / (0.44 * DAY), "textures/saturn_ring.png", 122170000.0, 136775000.0, 0.0 },
+        { "Uranus",   0, 19.2 * AU,      25362000.0,  8.6810e25,  0.5f, 1.0f, 1.0f, "textures/uranus.jpeg",  2 * M_PI / (0.72 * DAY), nullptr,                    0.0,         0.0,         0.0 },
+        { "Neptune",  0, 30.05 * AU,     24622000.0,  1.02413e26, 0.5f, 0.0f, 1.0f, "textures/neptune.jpeg", 2 * M_PI / (0.67 * DAY), nullptr,                    0.0,         0.0,         0.0 },
+    };
+    return bodies;
+}
+
+std::vector<BodyState> solarSystemInitialState() {
+    const std::vector<BodyDefinition>& bodies = solarSystemDefinition();
+    std::vector<BodyState> states(bodies.size());
+    for (size_t k = 0; k < bodies.size(); ++k) {
+        const BodyDefinition& body = bodies[k];
+        BodyState& state = states[k];
+        state.x = state.y = state.z = 0.0;
+        state.vx = state.vy = state.vz = 0.0;
+        state.mass = body.mass;
+        state.radius = body.radius;
+        if (body.parent >= 0) {
+            // Vitesse orbitale circulaire autour du parent, ajoutée à celle du parent
+            const BodyState& parent = states[body.parent];
+            state.x = parent.x + body.distance;
+            state.vy = parent.vy + sqrt(G * parent.mass / body.distance);
+        }
+    }
+    return states;
+}
+
+void addDefinedBody(std::vector<Planet>& planets, const BodyDefinition& body, const BodyState& state) {
+    planets.emplace_back(state.x, state.y, state.z, state.radius, state.mass, body.r, body.g, body.b,
+                         body.texturePath, body.rotationSpeed);
+    planets.back().id = static_cast<unsigned int>(planets.size() - 1);
+    if (body.ringTexturePath) {
+        createRingSystem(planets.back().rings, body.ringInnerRadius, body.ringOuterRadius, body.ringTilt,
+                         body.ringTexturePath);
+    }
+    planets.back().vx = state.vx;
+    planets.back().vy = state.vy;
+    planets.back().vz = state.vz;
+}
+
+void createSolarSystem(std::vector<Planet>& planets) {
+    const std::vector<BodyDefinition>& bodies = solarSystemDefinition();
+    std::vector<BodyState> states = solarSystemInitialState();
+    for (size_t k = 0; k < bodies.size(); ++k) {
+        addDefinedBody(planets, bodies[k], states[k]);
+    }
+}
+
+void addDebrisDisk(std::vector<Planet>& planets, int count, unsigned int seed) {
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<double> distance(2.1 * AU, 3.3 * AU);
+    std::uniform_real_distribution<double> angle(0.0, 2 * M_PI);
+    std::uniform_real_distribution<double> radius(1e5, 1e6); // Rayon en mètres
+    std::normal_distribution<double> dispersion(0.0, 0.01); // Écart relatif à la vitesse circulaire
+    const double density = 2000.0; // Masse volumique d'un astéroïde rocheux (kg/m³)
+
+    for (int k = 0; k < count; ++k) {
+        double d = distance(rng);
+        double theta = angle(rng);
+        double r = radius(rng);
+        double mass = density * 4.0 / 3.0 * M_PI * r * r * r;
+        double speed = sqrt(G * SUN_MASS / d);
+
+        planets.emplace_back(d * cos(theta), d * sin(theta), d * dispersion(rng), r, mass, 0.6f, 0.55f, 0.5f, nullptr);
+        planets.back().id = static_cast<unsigned int>(planets.size() - 1);
+        planets.back().vx = -speed * sin(theta) * (1.0 + dispersion(rng));
+        planets.back().vy = speed * cos(theta) * (1.0 + dispersion(rng));
+        planets.back().vz = speed * dispersion(rng);
+    }
+}
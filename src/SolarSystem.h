@@ -0,0 +1,47 @@
+// SolarSystem.h
+#ifndef SOLAR_SYSTEM_H
+#define SOLAR_SYSTEM_H
+
+#include <vector>
+#include "Planet.h"
+
+const double SUN_MASS = 1.989e30; // Masse du Soleil en kg
+const double DAY = 86400; // Secondes dans une journée
+
+// Description d'un corps du système solaire, indépendante d'OpenGL
+struct BodyDefinition {
+    const char* name;
+    int parent;              // Indice du corps central (-1 pour le Soleil)
+    double distance;         // Distance au corps central (en mètres)
+    double radius;           // Rayon (en mètres)
+    double mass;             // Masse (en kg)
+    float r, g, b;           // Couleur
+    const char* texturePath;
+    double rotationSpeed;    // Vitesse de rotation (radians par seconde)
+    const char* ringTexturePath; // nullptr si le corps n'a pas d'anneaux
+    double ringInnerRadius;      // Rayons des anneaux (en mètres)
+    double ringOuterRadius;
+    double ringTilt;             // Inclinaison des anneaux sur le plan de l'orbite (radians)
+};
+
+// État initial d'un corps : orbite circulaire dans le plan XY autour de son parent
+struct BodyState {
+    double x, y, z;
+    double vx, vy, vz;
+    double mass;
+    double radius;
+};
+
+const std::vector<BodyDefinition>& solarSystemDefinition();
+std::vector<BodyState> solarSystemInitialState();
+
+// Ajoute un corps du tableau avec sa texture et ses anneaux (contexte OpenGL requis)
+void addDefinedBody(std::vector<Planet>& planets, const BodyDefinition& body, const BodyState& state);
+
+// Crée les planètes et leurs anneaux (nécessite un contexte OpenGL pour les textures et les VBO)
+void createSolarSystem(std::vector<Planet>& planets);
+
+// Ajouter des débris sur des orbites quasi circulaires dans la ceinture d'astéroïdes
+void addDebrisDisk(std::vector<Planet>& planets, int count, unsigned int seed);
+
+#endif // SOLAR_SYSTEM_H
@@ -0,0 +1,144 @@
+// SpatialOrder.cpp
+#include "SpatialOrder.h"
+#include "Arena.h"
+#include "Parallel.h"
+#include "Physics.h"
+#include "SolarSystem.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+
+// Intercale deux bits nuls après chacun des 21 bits de poids faible
+static uint64_t spreadBits(uint64_t v) {
+    v &= 0x1fffff;
+    v = (v | v << 32) & 0x1f00000000ffffULL;
+    v = (v | v << 16) & 0x1f0000ff0000ffULL;
+    v = (v | v << 8) & 0x100f00f00f00f00fULL;
+    v = (v | v << 4) & 0x10c30c30c30c30c3ULL;
+    v = (v | v << 2) & 0x1249249249249249ULL;
+    return v;
+}
+
+uint64_t mortonKey(double x, double y, double z, const double lo[3], const double scale[3]) {
+    const double position[3] = { x, y, z };
+    uint64_t cell[3];
+    for (int c = 0; c < 3; ++c) {
+        double u = (position[c] - lo[c]) * scale[c];
+        cell[c] = static_cast<uint64_t>(std::min(std::max(u, 0.0), MORTON_CELLS));
+    }
+    return spreadBits(cell[0]) | spreadBits(cell[1]) << 1 | spreadBits(cell[2]) << 2;
+}
+
+struct MortonEntry {
+    uint64_t key;
+    size_t index;
+};
+
+static bool mortonEntryLess(const MortonEntry& a, const MortonEntry& b) {
+    if (a.key != b.key) return a.key < b.key;
+    return a.index < b.index;
+}
+
+void sortBodiesMorton(std::vector<Planet>& planets, std::vector<int>& remap) {
+    size_t n = planets.size();
+    remap.resize(n);
+    if (n < 2) {
+        for (size_t k = 0; k < n; ++k) {
+            remap[k] = static_cast<int>(k);
+        }
+        return;
+    }
+
+    double lo[3] = { planets[0].x, planets[0].y, planets[0].z };
+    double hi[3] = { lo[0], lo[1], lo[2] };
+    for (const auto& p : planets) {
+        const double position[3] = { p.x, p.y, p.z };
+        for (int c = 0; c < 3; ++c) {
+            lo[c] = std::min(lo[c], position[c]);
+            hi[c] = std::max(hi[c], position[c]);
+        }
+    }
+    double scale[3];
+    for (int c = 0; c < 3; ++c) {
+        scale[c] = hi[c] > lo[c] ? MORTON_CELLS / (hi[c] - lo[c]) : 0.0;
+    }
+
+    MortonEntry* entries = stepArena().allocateArray<MortonEntry>(n);
+    for (size_t k = 0; k < n; ++k) {
+        entries[k].key = mortonKey(planets[k].x, planets[k].y, planets[k].z, lo, scale);
+        entries[k].index = k;
+    }
+    std::sort(entries, entries + n, mortonEntryLess);
+
+    // Déplacement plutôt que copie : les trajectoires suivent leur corps sans être recopiées
+    std::vector<Planet> sorted;
+    sorted.reserve(n);
+    for (size_t k = 0; k < n; ++k) {
+        sorted.push_back(std::move(planets[entries[k].index]));
+        remap[entries[k].index] = static_cast<int>(k);
+    }
+    planets.swap(sorted);
+}
+
+// Meilleur temps (en millisecondes) sur plusieurs passes, accélérations remises à zéro avant chacune
+static double timeNearField(std::vector<Planet>& planets, double cutoff, int threads, size_t& pairs) {
+    const int repetitions = 5;
+    double best = 0.0;
+    for (int r = 0; r < repetitions; ++r) {
+        for (auto& p : planets) {
+            p.ax = p.ay = p.az = 0.0;
+        }
+        std::chrono::steady_clock::time_point begin = std::chrono::steady_clock::now();
+        pairs = computeNearFieldForces(planets, cutoff, threads);
+        double elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - begin).count();
+        resetStepArena();
+        if (r == 0 || elapsed < best) {
+            best = elapsed;
+        }
+    }
+    return best;
+}
+
+int runOrderBenchmark(const SimulationOptions& options) {
+    if (options.debrisCount <= 0) {
+        std::cerr << "--benchmark-order needs --debris N" << std::endl;
+        return -1;
+    }
+    // Débris seuls : ni texture ni contexte OpenGL nécessaires
+    std::vector<Planet> created;
+    addDebrisDisk(created, options.debrisCount, options.seed);
+    std::vector<Planet> ordered = created;
+
+    std::vector<int> remap;
+    std::chrono::steady_clock::time_point begin = std::chrono::steady_clock::now();
+    sortBodiesMorton(ordered, remap);
+    double sortTime = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - begin).count();
+    resetStepArena();
+
+    double cutoff = options.nearFieldCutoff * AU;
+    int threads = resolveThreadCount(options.threads);
+    size_t createdPairs, orderedPairs;
+    double createdTime = timeNearField(created, cutoff, threads, createdPairs);
+    double orderedTime = timeNearField(ordered, cutoff, threads, orderedPairs);
+
+    // Mêmes paires, sommées dans un autre ordre : seul l'arrondi diffère
+    double maxError = 0.0;
+    for (size_t k = 0; k < created.size(); ++k) {
+        const Planet& a = created[k];
+        const Planet& b = ordered[remap[k]];
+        double norm = sqrt(a.ax * a.ax + a.ay * a.ay + a.az * a.az);
+        double diff = sqrt((a.ax - b.ax) * (a.ax - b.ax) + (a.ay - b.ay) * (a.ay - b.ay) + (a.az - b.az) * (a.az - b.az));
+        if (norm > 0.0) {
+            maxError = std::max(maxError, diff / norm);
+        }
+    }
+
+    std::cout << "Near-field pass: " << created.size() << " bodies, cutoff " << options.nearFieldCutoff << " AU, "
+              << threads << " thread(s), tiles of " << NEAR_FIELD_TILE << std::endl;
+    std::cout << "  creation order: " << createdTime << " ms (" << createdPairs << " pairs)" << std::endl;
+    std::cout << "  Morton order:   " << orderedTime << " ms (" << orderedPairs << " pairs), sort " << sortTime << " ms"
+              << std::endl;
+    std::cout << "  speedup: " << createdTime / orderedTime << "x, max relative difference " << maxError << std::endl;
+    return createdPairs == orderedPairs ? 0 : 1;
+}
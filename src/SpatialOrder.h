@@ -0,0 +1,26 @@
+// SpatialOrder.h
+#ifndef SPATIAL_ORDER_H
+#define SPATIAL_ORDER_H
+
+#include <cstdint>
+#include <vector>
+#include "Planet.h"
+#include "Options.h"
+
+const int MORTON_BITS = 21;             // Bits par axe
+const double MORTON_CELLS = 2097151.0;  // 2^21 - 1 : plus grande coordonnée entière
+
+// Clé de Morton (ordre Z) : 21 bits par axe entrelacés, la position étant ramenée à [0, 1]
+// dans la boîte englobante. Deux clés proches désignent en général des points proches.
+uint64_t mortonKey(double x, double y, double z, const double lo[3], const double scale[3]);
+
+// Range le tableau le long de la courbe de Morton, pour que les corps voisins dans l'espace
+// le soient aussi en mémoire. remap[ancien indice] donne le nouvel indice (comme pour les
+// fusions) ; les identifiants des corps ne changent pas.
+void sortBodiesMorton(std::vector<Planet>& planets, std::vector<int>& remap);
+
+// Mode --benchmark-order : passe de forces à courte portée sur --debris corps, dans l'ordre
+// de création puis dans l'ordre de Morton ; affiche les temps et l'écart entre les résultats
+int runOrderBenchmark(const SimulationOptions& options);
+
+#endif // SPATIAL_ORDER_H
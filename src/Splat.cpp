@@ -0,0 +1,247 @@
+// Splat.cpp
+#include "Splat.h"
+#include "Arena.h"
+#include "Parallel.h"
+#include "Physics.h"
+#include "Scheduler.h"
+#include "SolarSystem.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <iostream>
+#include <limits>
+
+SplatRenderer::SplatRenderer(int width, int height, double extent)
+    : imageWidth(width), imageHeight(height), bandCount((height + SPLAT_BAND_ROWS - 1) / SPLAT_BAND_ROWS),
+      pixelSize(2.0 * extent / width), bandStart(bandCount + 1, 0),
+      density(static_cast<size_t>(width) * height, 0.0f), color(static_cast<size_t>(width) * height * 3, 0.0f) {
+}
+
+int SplatRenderer::width() const {
+    return imageWidth;
+}
+
+int SplatRenderer::height() const {
+    return imageHeight;
+}
+
+void SplatRenderer::render(const std::vector<Planet>& planets, int threads) {
+    const size_t count = planets.size();
+    const double halfWidth = 0.5 * pixelSize * imageWidth;
+    const double halfHeight = 0.5 * pixelSize * imageHeight;
+    screen.resize(count * 2);
+    std::vector<size_t> cursor(static_cast<size_t>(threads) * bandCount, 0);
+
+    // Bandes couvertes par un point : ses deux lignes de pixels, coupées aux bords de l'image
+    auto bands = [this](float py, int& first, int& last) {
+        int row = static_cast<int>(std::floor(py));
+        first = std::max(row, 0) / SPLAT_BAND_ROWS;
+        last = std::min(row + 1, imageHeight - 1) / SPLAT_BAND_ROWS;
+    };
+
+    // Projection et comptage des corps de chaque bande, par tranche
+    parallelFor(count, threads, [&](size_t begin, size_t end, int worker) {
+        size_t* counts = &cursor[static_cast<size_t>(worker) * bandCount];
+        for (size_t k = begin; k < end; ++k) {
+            double px = (planets[k].x + halfWidth) / pixelSize - 0.5;
+            double py = (halfHeight - planets[k].y) / pixelSize - 0.5;
+            // Un point à moins d'un pixel du bord touche encore l'image (positions NaN écartées aussi)
+            if (!(px >= -1.0 && px < imageWidth && py >= -1.0 && py < imageHeight)) {
+                screen[k * 2] = std::numeric_limits<float>::quiet_NaN();
+                continue;
+            }
+            screen[k * 2] = static_cast<float>(px);
+            screen[k * 2 + 1] = static_cast<float>(py);
+            int first, last;
+            bands(screen[k * 2 + 1], first, last);
+            ++counts[first];
+            if (last != first) {
+                ++counts[last];
+            }
+        }
+    });
+
+    // Décalages : bande par bande, les tranches dans l'ordre, donc les corps dans l'ordre du tableau
+    size_t total = 0;
+    for (int b = 0; b < bandCount; ++b) {
+        bandStart[b] = total;
+        for (int w = 0; w < threads; ++w) {
+            size_t n = cursor[static_cast<size_t>(w) * bandCount + b];
+            cursor[static_cast<size_t>(w) * bandCount + b] = total;
+            total += n;
+        }
+    }
+    bandStart[bandCount] = total;
+    entries.resize(total);
+
+    // Dispersion, avec le même découpage que le comptage
+    parallelFor(count, threads, [&](size_t begin, size_t end, int worker) {
+        size_t* next = &cursor[static_cast<size_t>(worker) * bandCount];
+        for (size_t k = begin; k < end; ++k) {
+            if (std::isnan(screen[k * 2])) {
+                continue;
+            }
+            int first, last;
+            bands(screen[k * 2 + 1], first, last);
+            entries[next[first]++] = static_cast<uint32_t>(k);
+            if (last != first) {
+                entries[next[last]++] = static_cast<uint32_t>(k);
+            }
+        }
+    });
+
+    // Accumulation : chaque bande n'écrit que ses propres lignes
+    parallelFor(bandCount, threads, [&](size_t begin, size_t end, int) {
+        for (size_t b = begin; b < end; ++b) {
+            int rowBegin = static_cast<int>(b) * SPLAT_BAND_ROWS;
+            int rowEnd = std::min(imageHeight, rowBegin + SPLAT_BAND_ROWS);
+            size_t pixelBegin = static_cast<size_t>(rowBegin) * imageWidth;
+            size_t pixelEnd = static_cast<size_t>(rowEnd) * imageWidth;
+            std::fill(density.begin() + pixelBegin, density.begin() + pixelEnd, 0.0f);
+            std::fill(color.begin() + pixelBegin * 3, color.begin() + pixelEnd * 3, 0.0f);
+
+            for (size_t e = bandStart[b]; e < bandStart[b + 1]; ++e) {
+                const Planet& planet = planets[entries[e]];
+                float px = screen[entries[e] * 2];
+                float py = screen[entries[e] * 2 + 1];
+                int x0 = static_cast<int>(std::floor(px));
+                int y0 = static_cast<int>(std::floor(py));
+                float fx = px - x0;
+                float fy = py - y0;
+                for (int dy = 0; dy < 2; ++dy) {
+                    int row = y0 + dy;
+                    if (row < rowBegin || row >= rowEnd) {
+                        continue;
+                    }
+                    float wy = dy ? fy : 1.0f - fy;
+                    for (int dx = 0; dx < 2; ++dx) {
+                        int column = x0 + dx;
+                        if (column < 0 || column >= imageWidth) {
+                            continue;
+                        }
+                        float weight = wy * (dx ? fx : 1.0f - fx);
+                        size_t pixel = static_cast<size_t>(row) * imageWidth + column;
+                        density[pixel] += weight;
+                        color[pixel * 3] += weight * planet.r;
+                        color[pixel * 3 + 1] += weight * planet.g;
+                        color[pixel * 3 + 2] += weight * planet.b;
+                    }
+                }
+            }
+        }
+    });
+}
+
+void SplatRenderer::toneMap(std::vector<unsigned char>& rgb, int threads) const {
+    // Exposition : un quantile élevé plutôt que le maximum, qu'un seul pixel surchargé (le Soleil,
+    // un amas) suffirait à fixer
+    std::vector<float> occupied;
+    for (float d : density) {
+        if (d > 0.0f) {
+            occupied.push_back(d);
+        }
+    }
+    double reference = 1.0;
+    if (!occupied.empty()) {
+        size_t rank = static_cast<size_t>(SPLAT_EXPOSURE_PERCENTILE * (occupied.size() - 1));
+        std::nth_element(occupied.begin(), occupied.begin() + rank, occupied.end());
+        reference = std::max(1.0, static_cast<double>(occupied[rank]));
+    }
+    const double scale = 1.0 / log1p(reference);
+
+    rgb.resize(density.size() * 3);
+    parallelFor(imageHeight, threads, [&](size_t begin, size_t end, int) {
+        for (size_t pixel = begin * imageWidth; pixel < end * imageWidth; ++pixel) {
+            double d = density[pixel];
+            if (d <= 0.0) {
+                rgb[pixel * 3] = rgb[pixel * 3 + 1] = rgb[pixel * 3 + 2] = 0;
+                continue;
+            }
+            double brightness = pow(std::min(1.0, log1p(d) * scale), 1.0 / SPLAT_GAMMA);
+            for (int c = 0; c < 3; ++c) {
+                double value = color[pixel * 3 + c] / d * brightness; // Couleur moyenne du pixel
+                rgb[pixel * 3 + c] = static_cast<unsigned char>(std::min(1.0, value) * 255.0 + 0.5);
+            }
+        }
+    });
+}
+
+static bool writeSplatImage(const char* pattern, int frame, int width, int height, const std::vector<unsigned char>& rgb) {
+    std::string path = framePath(pattern, frame);
+    FILE* file = fopen(path.c_str(), "wb");
+    if (!file) {
+        std::cerr << "Failed to open splat image: " << path << std::endl;
+        return false;
+    }
+    fprintf(file, "P6\n%d %d\n255\n", width, height);
+    bool written = fwrite(rgb.data(), 1, rgb.size(), file) == rgb.size();
+    fclose(file);
+    if (!written) {
+        std::cerr << "Failed to write splat image: " << path << std::endl;
+    }
+    return written;
+}
+
+// Corps du système solaire sans texture ni anneaux (aucun contexte OpenGL), puis les débris
+static void createBodies(const SimulationOptions& options, std::vector<Planet>& planets) {
+    const std::vector<BodyDefinition>& bodies = solarSystemDefinition();
+    std::vector<BodyState> states = solarSystemInitialState();
+    planets.reserve(bodies.size() + options.debrisCount);
+    for (size_t k = 0; k < bodies.size(); ++k) {
+        const BodyState& s = states[k];
+        planets.emplace_back(s.x, s.y, s.z, s.radius, s.mass, bodies[k].r, bodies[k].g, bodies[k].b, nullptr,
+                             bodies[k].rotationSpeed);
+        planets.back().id = static_cast<unsigned int>(k);
+        planets.back().vx = s.vx;
+        planets.back().vy = s.vy;
+        planets.back().vz = s.vz;
+    }
+    addDebrisDisk(planets, options.debrisCount, options.seed);
+    assignSoftening(planets, options.softeningLength, options.softeningRadius);
+}
+
+int runSplat(const SimulationOptions& options) {
+    std::vector<Planet> planets;
+    createBodies(options, planets);
+    int threads = resolveThreadCount(options.threads);
+    SplatRenderer splat(options.splatWidth, options.splatHeight, options.splatExtent * AU);
+    std::vector<unsigned char> rgb;
+
+    // Pas sans trajectoires (Planet::advance) : un million de corps n'en garderait pas en mémoire
+    TaskGraph graph;
+    std::vector<int> remap;
+    double stepTime = 0.0, renderTime = 0.0;
+    for (int frame = 0; frame < options.splatFrames; ++frame) {
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        for (int step = 0; frame > 0 && step < options.splatInterval; ++step) {
+            graph.clear();
+            addForceTasks(graph, planets, options.forceMethod, options.theta, options.threads, options.deterministic);
+            graph.run(threads);
+            parallelFor(planets.size(), threads, [&planets, &options](size_t begin, size_t end, int) {
+                for (size_t k = begin; k < end; ++k) {
+                    planets[k].advance(options.dt);
+                }
+            });
+            if (options.collisionMode != COLLISION_OFF) {
+                handleCollisions(planets, options.dt, options.collisionMode, options.restitution, remap);
+            }
+            resetStepArena();
+        }
+        std::chrono::steady_clock::time_point stepped = std::chrono::steady_clock::now();
+        splat.render(planets, threads);
+        splat.toneMap(rgb, threads);
+        std::chrono::steady_clock::time_point rendered = std::chrono::steady_clock::now();
+        stepTime += std::chrono::duration<double>(stepped - start).count();
+        renderTime += std::chrono::duration<double, std::milli>(rendered - stepped).count();
+
+        if (!writeSplatImage(options.splatTarget, frame, splat.width(), splat.height(), rgb)) {
+            return -1;
+        }
+    }
+
+    std::cerr << "Splat: " << planets.size() << " bodies, " << options.splatFrames << " frame(s) of "
+              << splat.width() << "x" << splat.height() << " on " << threads << " thread(s), "
+              << renderTime / options.splatFrames << " ms per frame (physics " << stepTime << " s)" << std::endl;
+    return 0;
+}
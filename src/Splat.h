@@ -0,0 +1,49 @@
+// Splat.h
+#ifndef SPLAT_H
+#define SPLAT_H
+
+#include <cstdint>
+#include <vector>
+#include "Planet.h"
+#include "Options.h"
+
+const int SPLAT_BAND_ROWS = 16;                 // Lignes par bande, chaque bande accumulée par un seul thread
+const double SPLAT_EXPOSURE_PERCENTILE = 0.995; // Quantile des densités non nulles ramené au blanc
+const double SPLAT_GAMMA = 2.2;
+
+// Rastérisation des corps en points sur CPU, sans OpenGL : vue orthographique du plan XY,
+// vue de dessus, centrée sur l'origine. Chaque corps dépose un poids unité réparti sur ses quatre
+// pixels voisins (interpolation bilinéaire), et sa couleur avec le même poids. Les corps sont
+// d'abord rangés par bandes de SPLAT_BAND_ROWS lignes (comptage puis dispersion, une tranche de
+// corps par thread), puis chaque bande est accumulée par un seul thread : aucune écriture
+// concurrente, aucune image partielle à réduire, et dans chaque bande les corps gardent l'ordre du
+// tableau, si bien que l'image ne dépend pas du nombre de threads.
+class SplatRenderer {
+public:
+    // extent : demi-largeur de la vue (en mètres) ; la hauteur suit les proportions de l'image
+    SplatRenderer(int width, int height, double extent);
+
+    void render(const std::vector<Planet>& planets, int threads);
+
+    // Luminosité logarithmique de la densité, normalisée par SPLAT_EXPOSURE_PERCENTILE, puis
+    // gamma ; la teinte est la couleur moyenne des corps du pixel. RGB 8 bits, première ligne en haut.
+    void toneMap(std::vector<unsigned char>& rgb, int threads) const;
+
+    int width() const;
+    int height() const;
+
+private:
+    int imageWidth, imageHeight, bandCount;
+    double pixelSize; // Mètres par pixel
+
+    std::vector<float> screen;          // Position de chaque corps en pixels (x, y), NaN hors de l'image
+    std::vector<size_t> bandStart;      // Début des entrées de chaque bande dans entries (bandCount + 1)
+    std::vector<uint32_t> entries;      // Indices des corps, bande par bande
+    std::vector<float> density;         // Poids accumulé par pixel
+    std::vector<float> color;           // Couleur accumulée par pixel (r, g, b)
+};
+
+// Mode --splat : simule le système solaire et --debris corps sans fenêtre et écrit des aperçus PPM
+int runSplat(const SimulationOptions& options);
+
+#endif // SPLAT_H
@@ -0,0 +1,11 @@
+// Texture.h
+#ifndef TEXTURE_H
+#define TEXTURE_H
+
+#include <GL/glew.h>
+
+// Charge une image en texture 2D avec mipmaps (contexte OpenGL requis).
+// Retourne 0 si l'image est illisible : une texture incomplète échantillonne du noir en profil core.
+GLuint loadTexture(const char* path);
+
+#endif // TEXTURE_H
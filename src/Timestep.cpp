@@ -0,0 +1,67 @@
+// Timestep.cpp
+#include "Timestep.h"
+#include "Parallel.h"
+#include <algorithm>
+#include <cmath>
+
+TimestepController::TimestepController(double initial, double tolerance, double minimum, double maximum)
+    : tolerance(tolerance), minimum(minimum), maximum(maximum), current(initial), measured(initial), error(0.0) {
+    if (adaptive()) {
+        current = measured = std::min(maximum, std::max(minimum, initial));
+    }
+}
+
+bool TimestepController::adaptive() const {
+    return tolerance > 0.0;
+}
+
+double TimestepController::step() const {
+    return current;
+}
+
+double TimestepController::lastError() const {
+    return error;
+}
+
+void TimestepController::reset() {
+    previous.clear();
+}
+
+void TimestepController::estimate(const std::vector<Planet>& planets, int threads) {
+    const size_t count = planets.size();
+    bool history = previous.size() == count * 3;
+    previous.resize(count * 3);
+
+    // Écart relatif maximal de chaque tranche, puis maximum des tranches
+    std::vector<double> partial(std::max(threads, 1), 0.0);
+    parallelFor(count, threads, [&](size_t begin, size_t end, int worker) {
+        double worst = 0.0;
+        for (size_t k = begin; k < end; ++k) {
+            const Planet& p = planets[k];
+            double* last = &previous[k * 3];
+            if (history) {
+                double a2 = p.ax * p.ax + p.ay * p.ay + p.az * p.az;
+                double dx = p.ax - last[0], dy = p.ay - last[1], dz = p.az - last[2];
+                if (a2 > 0.0) {
+                    worst = std::max(worst, 0.5 * sqrt((dx * dx + dy * dy + dz * dz) / a2));
+                }
+            }
+            last[0] = p.ax;
+            last[1] = p.ay;
+            last[2] = p.az;
+        }
+        partial[worker] = worst;
+    });
+    if (!history) {
+        measured = current; // Première passe : rien à comparer, le pas ne change pas
+        return;
+    }
+    error = *std::max_element(partial.begin(), partial.end());
+
+    // L'erreur mesurée correspond au pas measured ; elle lui est proportionnelle
+    double factor = error > 0.0 ? TIMESTEP_SAFETY * tolerance / error : TIMESTEP_MAX_GROWTH;
+    factor = std::min(TIMESTEP_MAX_GROWTH, std::max(TIMESTEP_MAX_SHRINK, factor));
+    double next = std::min(maximum, std::max(minimum, measured * factor));
+    measured = current;
+    current = next;
+}
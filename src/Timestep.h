@@ -0,0 +1,44 @@
+// Timestep.h
+#ifndef TIMESTEP_H
+#define TIMESTEP_H
+
+#include <vector>
+#include "Planet.h"
+
+const double TIMESTEP_SAFETY = 0.8;     // Marge sous la tolérance pour le pas suivant
+const double TIMESTEP_MAX_GROWTH = 2.0; // Facteurs de variation maximale d'un pas au suivant
+const double TIMESTEP_MAX_SHRINK = 0.2;
+
+// Pas de temps global adaptatif (--adaptive-dt). L'estimateur est emboîté dans l'intégrateur :
+// Euler symplectique applique a_n dt à la vitesse, la méthode du trapèze (un ordre de plus)
+// appliquerait (a_n + a_n+1) dt / 2 ; leur écart relatif sur l'incrément de vitesse d'un corps
+// vaut |a_n+1 - a_n| / (2 |a_n|). Il se mesure sans évaluation de force supplémentaire en
+// comparant les accélérations de deux passes de forces consécutives. L'erreur retenue est le
+// maximum sur les corps ; elle est proportionnelle au pas, d'où le pas suivant
+// dt * TIMESTEP_SAFETY * tolérance / erreur, borné en variation et dans [minimum, maximum].
+// L'estimation du pas n choisit le pas n + 1 : les tâches d'intégration du pas n ont déjà reçu
+// le leur. Sans tolérance (0), le pas reste fixe et estimate n'est jamais appelée.
+class TimestepController {
+public:
+    TimestepController(double initial, double tolerance, double minimum, double maximum);
+
+    bool adaptive() const;
+    double step() const;       // Pas du prochain appel à simulateStep (en secondes)
+    double lastError() const;  // Dernière erreur estimée (0 avant la deuxième passe de forces)
+
+    // Entre la passe de forces et l'intégration (accélérations fraîches) ; la boucle sur les corps
+    // est répartie sur threads, le résultat n'en dépend pas (maximum)
+    void estimate(const std::vector<Planet>& planets, int threads);
+
+    // Corps réordonnés ou fusionnés : les accélérations mémorisées ne correspondent plus
+    void reset();
+
+private:
+    double tolerance, minimum, maximum;
+    double current;  // Pas choisi pour le prochain pas
+    double measured; // Pas qui sépare les accélérations mémorisées des prochaines
+    double error;
+    std::vector<double> previous; // Accélérations de la passe précédente (ax, ay, az par corps)
+};
+
+#endif // TIMESTEP_H
@@ -0,0 +1,111 @@
+// Trajectory.cpp
+#include "Trajectory.h"
+#include "Profiler.h"
+#include <algorithm>
+
+static const size_t CHUNK_COUNT = (TRAJECTORY_LENGTH + TRAJECTORY_CHUNK - 1) / TRAJECTORY_CHUNK;
+
+Trajectory::Trajectory() : head(0), count(0) {}
+
+void Trajectory::push(double x, double y) {
+    if (points.empty()) {
+        points.resize(TRAJECTORY_LENGTH);
+        bounds.resize(CHUNK_COUNT);
+    }
+    size_t slot = head + count;
+    if (slot >= TRAJECTORY_LENGTH) {
+        slot -= TRAJECTORY_LENGTH;
+    }
+    points[slot] = std::make_pair(x, y);
+
+    // Avant le premier tour, les emplacements se remplissent dans l'ordre : la boîte est exacte.
+    // Ensuite elle ne fait que grandir (les anciens points du morceau sont encore tracés) jusqu'à
+    // ce que le morceau soit entièrement réécrit, où elle est recalculée.
+    size_t chunk = slot / TRAJECTORY_CHUNK;
+    ChunkBounds& box = bounds[chunk];
+    if (slot % TRAJECTORY_CHUNK == 0 && count < TRAJECTORY_LENGTH) {
+        box.lo[0] = box.hi[0] = x;
+        box.lo[1] = box.hi[1] = y;
+    } else {
+        box.lo[0] = std::min(box.lo[0], x);
+        box.hi[0] = std::max(box.hi[0], x);
+        box.lo[1] = std::min(box.lo[1], y);
+        box.hi[1] = std::max(box.hi[1], y);
+    }
+    if (count == TRAJECTORY_LENGTH && slot + 1 == std::min(TRAJECTORY_LENGTH, (chunk + 1) * TRAJECTORY_CHUNK)) {
+        recomputeBounds(chunk);
+    }
+
+    if (count < TRAJECTORY_LENGTH) {
+        ++count;
+    } else if (++head == TRAJECTORY_LENGTH) {
+        head = 0;
+    }
+}
+
+void Trajectory::recomputeBounds(size_t chunk) {
+    size_t begin = chunk * TRAJECTORY_CHUNK;
+    size_t end = std::min(TRAJECTORY_LENGTH, begin + TRAJECTORY_CHUNK);
+    ChunkBounds& box = bounds[chunk];
+    box.lo[0] = box.hi[0] = points[begin].first;
+    box.lo[1] = box.hi[1] = points[begin].second;
+    for (size_t slot = begin + 1; slot < end; ++slot) {
+        box.lo[0] = std::min(box.lo[0], points[slot].first);
+        box.hi[0] = std::max(box.hi[0], points[slot].first);
+        box.lo[1] = std::min(box.lo[1], points[slot].second);
+        box.hi[1] = std::max(box.hi[1], points[slot].second);
+    }
+}
+
+void Trajectory::clear() {
+    head = 0;
+    count = 0;
+}
+
+size_t Trajectory::size() const {
+    return count;
+}
+
+const std::pair<double, double>& Trajectory::operator[](size_t index) const {
+    size_t slot = head + index;
+    return points[slot >= TRAJECTORY_LENGTH ? slot - TRAJECTORY_LENGTH : slot];
+}
+
+size_t Trajectory::visibleRuns(const Frustum& frustum, size_t* first, size_t* last) const {
+    size_t runs = 0;
+    size_t index = 0;
+    while (index < count) {
+        // Morceau logique : jusqu'à la fin du morceau d'emplacements qui contient ce point
+        size_t slot = head + index;
+        if (slot >= TRAJECTORY_LENGTH) {
+            slot -= TRAJECTORY_LENGTH;
+        }
+        size_t chunk = slot / TRAJECTORY_CHUNK;
+        size_t end = index + std::min(TRAJECTORY_LENGTH, (chunk + 1) * TRAJECTORY_CHUNK) - slot;
+        end = std::min(end, count);
+
+        const ChunkBounds& box = bounds[chunk];
+        const double lo[3] = { box.lo[0], box.lo[1], 0.0 };
+        const double hi[3] = { box.hi[0], box.hi[1], 0.0 };
+        if (frustum.containsBox(lo, hi)) {
+            if (runs > 0 && last[runs - 1] == index) {
+                last[runs - 1] = end;
+            } else {
+                first[runs] = index;
+                last[runs] = end;
+                ++runs;
+            }
+            profilerAdd(PROFILE_TRAJECTORY_CHUNKS_DRAWN);
+        } else {
+            profilerAdd(PROFILE_TRAJECTORY_CHUNKS_CULLED);
+        }
+        index = end;
+    }
+
+    // Un point de raccord de chaque côté
+    for (size_t k = 0; k < runs; ++k) {
+        first[k] = first[k] > 0 ? first[k] - 1 : 0;
+        last[k] = std::min(last[k] + 1, count);
+    }
+    return runs;
+}
@@ -0,0 +1,46 @@
+// Trajectory.h
+#ifndef TRAJECTORY_H
+#define TRAJECTORY_H
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+#include "Frustum.h"
+
+const size_t TRAJECTORY_LENGTH = 1000; // Points conservés par trajectoire
+const size_t TRAJECTORY_CHUNK = 64;    // Points par morceau, chacun avec sa boîte englobante
+const size_t TRAJECTORY_MAX_RUNS = TRAJECTORY_LENGTH / TRAJECTORY_CHUNK + 2; // Suites au plus par visibleRuns
+
+// Tampon circulaire des dernières positions (en unités astronomiques) : ajouter un point
+// écrase le plus ancien une fois la capacité atteinte, sans décaler ni réallouer.
+class Trajectory {
+public:
+    Trajectory();
+
+    void push(double x, double y);
+    void clear();
+    size_t size() const;
+
+    // Du plus ancien (0) au plus récent (size() - 1)
+    const std::pair<double, double>& operator[](size_t index) const;
+
+    // Suites de points à tracer : les morceaux dont la boîte englobante (plan z = 0) sort de la
+    // pyramide sont sautés, les morceaux visibles consécutifs sont fusionnés. Chaque suite
+    // [first[k], last[k]) déborde d'un point de chaque côté pour que les segments qui entrent
+    // dans le champ restent tracés. Au plus TRAJECTORY_MAX_RUNS suites ; renvoie leur nombre.
+    size_t visibleRuns(const Frustum& frustum, size_t* first, size_t* last) const;
+
+private:
+    struct ChunkBounds {
+        double lo[2], hi[2];
+    };
+
+    void recomputeBounds(size_t chunk);
+
+    std::vector<std::pair<double, double>> points; // Alloué une fois à TRAJECTORY_LENGTH
+    std::vector<ChunkBounds> bounds; // Par morceau de TRAJECTORY_CHUNK emplacements de points
+    size_t head;  // Indice du plus ancien point
+    size_t count;
+};
+
+#endif // TRAJECTORY_H
@@ -0,0 +1,248 @@
+// Transport.cpp
+#include "Transport.h"
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+#include <iostream>
+#include <new>
+#include <thread>
+#include <poll.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#ifndef MSG_NOSIGNAL
+#define MSG_NOSIGNAL 0 // macOS : SO_NOSIGPIPE est posé sur chaque socket à la création
+#endif
+
+static const size_t SHARED_RING_BYTES = 1 << 20; // Capacité de chaque anneau en mémoire partagée
+
+// En-tête d'un anneau : compteurs d'octets écrits et lus depuis la création, sur des lignes
+// de cache distinctes (un seul écrivain et un seul lecteur, dans deux processus différents)
+struct SharedRing {
+    std::atomic<uint64_t> head;
+    char headPadding[64 - sizeof(std::atomic<uint64_t>)];
+    std::atomic<uint64_t> tail;
+    char tailPadding[64 - sizeof(std::atomic<uint64_t>)];
+};
+
+static const size_t SHARED_CHANNEL_BYTES = sizeof(SharedRing) + SHARED_RING_BYTES;
+
+Transport::Transport()
+    : kind(TRANSPORT_SOCKET), ranks(0), self(0), shared(nullptr), sharedBytes(0), sent(0) {}
+
+Transport::~Transport() {
+    destroy();
+}
+
+bool Transport::create(TransportKind _kind, int _ranks) {
+    destroy();
+    kind = _kind;
+    ranks = _ranks;
+    if (kind == TRANSPORT_SOCKET) {
+        sockets.assign(static_cast<size_t>(ranks) * ranks, -1);
+        for (int a = 0; a < ranks; ++a) {
+            for (int b = a + 1; b < ranks; ++b) {
+                int pair[2];
+                if (socketpair(AF_UNIX, SOCK_STREAM, 0, pair) != 0) {
+                    std::cerr << "Failed to create socket pair: " << strerror(errno) << std::endl;
+                    destroy();
+                    return false;
+                }
+#ifdef SO_NOSIGPIPE
+                int on = 1;
+                setsockopt(pair[0], SOL_SOCKET, SO_NOSIGPIPE, &on, sizeof(on));
+                setsockopt(pair[1], SOL_SOCKET, SO_NOSIGPIPE, &on, sizeof(on));
+#endif
+                sockets[a * ranks + b] = pair[0];
+                sockets[b * ranks + a] = pair[1];
+            }
+        }
+        return true;
+    }
+
+    // Anonyme et partagée : héritée telle quelle par les processus créés par fork()
+    sharedBytes = static_cast<size_t>(ranks) * ranks * SHARED_CHANNEL_BYTES;
+    void* memory = mmap(nullptr, sharedBytes, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+    if (memory == MAP_FAILED) {
+        std::cerr << "Failed to map shared memory: " << strerror(errno) << std::endl;
+        sharedBytes = 0;
+        return false;
+    }
+    shared = static_cast<char*>(memory);
+    for (int c = 0; c < ranks * ranks; ++c) {
+        SharedRing* ring = new (shared + c * SHARED_CHANNEL_BYTES) SharedRing;
+        ring->head.store(0, std::memory_order_relaxed);
+        ring->tail.store(0, std::memory_order_relaxed);
+    }
+    return true;
+}
+
+void Transport::attach(int rank) {
+    self = rank;
+    // Fermer les extrémités des autres couples : une fin de processus est alors vue par ses pairs
+    for (size_t k = 0; k < sockets.size(); ++k) {
+        if (static_cast<int>(k) / ranks != rank && sockets[k] >= 0) {
+            close(sockets[k]);
+            sockets[k] = -1;
+        }
+    }
+}
+
+void Transport::destroy() {
+    for (int fd : sockets) {
+        if (fd >= 0) {
+            close(fd);
+        }
+    }
+    sockets.clear();
+    if (shared) {
+        munmap(shared, sharedBytes);
+        shared = nullptr;
+        sharedBytes = 0;
+    }
+}
+
+long Transport::trySend(int to, const char* data, size_t bytes) {
+    if (kind == TRANSPORT_SOCKET) {
+        ssize_t written = send(sockets[self * ranks + to], data, bytes, MSG_DONTWAIT | MSG_NOSIGNAL);
+        if (written < 0) {
+            return errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR ? 0 : -1;
+        }
+        return static_cast<long>(written);
+    }
+
+    char* channel = shared + (self * ranks + to) * SHARED_CHANNEL_BYTES;
+    SharedRing* ring = reinterpret_cast<SharedRing*>(channel);
+    char* data0 = channel + sizeof(SharedRing);
+    uint64_t head = ring->head.load(std::memory_order_relaxed);
+    uint64_t tail = ring->tail.load(std::memory_order_acquire);
+    size_t count = std::min<size_t>(bytes, SHARED_RING_BYTES - static_cast<size_t>(head - tail));
+    size_t offset = static_cast<size_t>(head % SHARED_RING_BYTES);
+    size_t first = std::min(count, SHARED_RING_BYTES - offset);
+    memcpy(data0 + offset, data, first);
+    memcpy(data0, data + first, count - first);
+    ring->head.store(head + count, std::memory_order_release);
+    return static_cast<long>(count);
+}
+
+long Transport::tryReceive(int from, char* data, size_t bytes) {
+    if (kind == TRANSPORT_SOCKET) {
+        ssize_t received = recv(sockets[self * ranks + from], data, bytes, MSG_DONTWAIT);
+        if (received < 0) {
+            return errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR ? 0 : -1;
+        }
+        return received == 0 && bytes > 0 ? -1 : static_cast<long>(received); // 0 : pair fermé
+    }
+
+    char* channel = shared + (from * ranks + self) * SHARED_CHANNEL_BYTES;
+    SharedRing* ring = reinterpret_cast<SharedRing*>(channel);
+    const char* data0 = channel + sizeof(SharedRing);
+    uint64_t tail = ring->tail.load(std::memory_order_relaxed);
+    uint64_t head = ring->head.load(std::memory_order_acquire);
+    size_t count = std::min<size_t>(bytes, static_cast<size_t>(head - tail));
+    size_t offset = static_cast<size_t>(tail % SHARED_RING_BYTES);
+    size_t first = std::min(count, SHARED_RING_BYTES - offset);
+    memcpy(data, data0 + offset, first);
+    memcpy(data + first, data0, count - first);
+    ring->tail.store(tail + count, std::memory_order_release);
+    return static_cast<long>(count);
+}
+
+void Transport::waitForProgress(int to, int from) {
+    if (kind == TRANSPORT_SHARED_MEMORY) {
+        std::this_thread::yield();
+        return;
+    }
+    pollfd fds[2];
+    int count = 0;
+    if (to >= 0) {
+        fds[count].fd = sockets[self * ranks + to];
+        fds[count].events = POLLOUT;
+        ++count;
+    }
+    if (from >= 0) {
+        fds[count].fd = sockets[self * ranks + from];
+        fds[count].events = POLLIN;
+        ++count;
+    }
+    poll(fds, count, 10);
+}
+
+bool Transport::exchange(int to, const std::vector<char>& out, int from, std::vector<char>& in) {
+    // Chaque message est précédé de sa longueur sur 8 octets
+    uint64_t outLength = out.size(), inLength = 0;
+    const size_t header = sizeof(uint64_t);
+    size_t outDone = to >= 0 ? 0 : header + out.size();
+    size_t inDone = 0;
+    bool receiving = from >= 0;
+    if (!receiving) {
+        in.clear();
+    }
+
+    while (outDone < header + out.size() || receiving) {
+        bool progress = false;
+        if (outDone < header + out.size()) {
+            long written = outDone < header
+                               ? trySend(to, reinterpret_cast<const char*>(&outLength) + outDone, header - outDone)
+                               : trySend(to, out.data() + (outDone - header), out.size() - (outDone - header));
+            if (written < 0) {
+                std::cerr << "Failed to send to rank " << to << std::endl;
+                return false;
+            }
+            outDone += written;
+            sent += written;
+            progress = progress || written > 0;
+        }
+        if (receiving) {
+            long received;
+            if (inDone < header) {
+                received = tryReceive(from, reinterpret_cast<char*>(&inLength) + inDone, header - inDone);
+            } else {
+                received = tryReceive(from, in.data() + (inDone - header), in.size() - (inDone - header));
+            }
+            if (received < 0) {
+                std::cerr << "Failed to receive from rank " << from << std::endl;
+                return false;
+            }
+            size_t before = inDone;
+            inDone += received;
+            if (before < header && inDone == header) {
+                in.resize(static_cast<size_t>(inLength));
+            }
+            receiving = inDone < header || inDone < header + in.size();
+            progress = progress || received > 0;
+        }
+        if (!progress) {
+            waitForProgress(outDone < header + out.size() ? to : -1, receiving ? from : -1);
+        }
+    }
+    return true;
+}
+
+bool Transport::allToAll(const std::vector<std::vector<char>>& out, std::vector<std::vector<char>>& in) {
+    in.resize(ranks);
+    in[self] = out[self];
+    for (int k = 1; k < ranks; ++k) {
+        int to = (self + k) % ranks;
+        int from = (self - k + ranks) % ranks;
+        if (!exchange(to, out[to], from, in[from])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool Transport::allGather(const std::vector<char>& out, std::vector<std::vector<char>>& in) {
+    in.resize(ranks);
+    in[self] = out;
+    for (int k = 1; k < ranks; ++k) {
+        int to = (self + k) % ranks;
+        int from = (self - k + ranks) % ranks;
+        if (!exchange(to, out, from, in[from])) {
+            return false;
+        }
+    }
+    return true;
+}
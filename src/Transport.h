@@ -0,0 +1,55 @@
+// Transport.h
+#ifndef TRANSPORT_H
+#define TRANSPORT_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+enum TransportKind {
+    TRANSPORT_SOCKET,       // Une paire de sockets Unix par couple de processus
+    TRANSPORT_SHARED_MEMORY // Un anneau d'octets en mémoire partagée par sens et par couple
+};
+
+// Canaux point à point entre processus d'une même machine, à la manière de MPI : chaque
+// processus a un rang dans [0, size()). Les canaux sont créés avant fork() puis chaque
+// processus n'en garde que les extrémités qui le concernent (attach). Les messages sont des
+// tampons d'octets de taille quelconque ; le mécanisme sous-jacent ne change que create().
+class Transport {
+public:
+    Transport();
+    ~Transport();
+
+    bool create(TransportKind kind, int ranks);
+    void attach(int rank);
+    void destroy();
+
+    int rank() const { return self; }
+    int size() const { return ranks; }
+    uint64_t bytesSent() const { return sent; }
+
+    // Envoie out à to tout en recevant de from (-1 : pas d'envoi ou pas de réception). Les deux
+    // sens progressent ensemble : deux processus qui s'envoient mutuellement plus que la
+    // capacité du canal ne se bloquent pas.
+    bool exchange(int to, const std::vector<char>& out, int from, std::vector<char>& in);
+
+    // Échanges collectifs, en size() - 1 tours : au tour k, envoi à rang + k et réception de
+    // rang - k. out[r] est destiné au rang r ; in[r] a été envoyé par r (in[rank()] = out[rank()]).
+    bool allToAll(const std::vector<std::vector<char>>& out, std::vector<std::vector<char>>& in);
+    bool allGather(const std::vector<char>& out, std::vector<std::vector<char>>& in);
+
+private:
+    long trySend(int to, const char* data, size_t bytes);   // Octets écrits sans attendre, -1 si erreur
+    long tryReceive(int from, char* data, size_t bytes);    // Octets lus sans attendre, -1 si erreur
+    void waitForProgress(int to, int from);
+
+    TransportKind kind;
+    int ranks;
+    int self;
+    std::vector<int> sockets; // sockets[a * ranks + b] : extrémité de a vers b
+    char* shared;             // Anneaux de tous les couples (a, b), dans le même ordre
+    size_t sharedBytes;
+    uint64_t sent;
+};
+
+#endif // TRANSPORT_H
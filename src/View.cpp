@@ -1,5 +1,11 @@
 // View.cpp
 #include "View.h"
+#include "Camera.h"
+#include "CoreRenderer.h"
+#include "DepthTarget.h"
+#include "Matrix.h"
+#include "Occlusion.h"
+#include "RenderQueue.h"
 #include <GL/glew.h>
 #include <GLFW/glfw3.h>
 #include <OpenGL/glu.h>
@@ -9,7 +15,8 @@
 // Définir des variables globales pour le zoom et la rotation
 static double zoomFactor = 0.0001; // Facteur de zoom initial (en unités astronomiques)
 static const double zoomIncrement = 0.001; // Incrément de zoom
-int planetFocus = 3; // Index de la planète à focaliser
+static unsigned int focusId = 3; // Identifiant stable du corps focalisé (Planet::id ; 3 : la Terre)
+int planetFocus = 3;             // Son indice dans le tableau, retrouvé d'après focusId
 
 static double cameraTheta = 0.0; // Angle de rotation autour de l'axe Y (horizontal)
 static double cameraPhi = 0.0;   // Angle de rotation autour de l'axe X (vertical)
@@ -17,7 +24,37 @@ static double lastMouseX = 0.0;  // Dernière position de la souris en X
 static double lastMouseY = 0.0;  // Dernière position de la souris en Y
 static bool isDragging = false;  // Indique si la souris est en train de glisser (dragging)
 
+static RendererBackend rendererBackend = RENDERER_LEGACY;
+static bool occlusionCulling = false;
+static DepthMode depthMode = DEPTH_STANDARD;
+static DepthTarget depthTarget; // Profondeur flottante inversée
+static CoreRenderer coreRenderer;
+static RenderQueue renderQueue; // Pipeline fixe : éléments triés par état
+static RenderState renderState;
+
+bool initRenderer(RendererBackend backend, DepthMode depth) {
+    rendererBackend = backend;
+    if (depth == DEPTH_REVERSE_Z && !DepthTarget::supported()) {
+        std::cerr << "Reverse-Z depth needs glClipControl (OpenGL 4.5 or ARB_clip_control), using standard depth" << std::endl;
+        depth = DEPTH_STANDARD;
+    }
+    if (depth == DEPTH_LOGARITHMIC && backend != RENDERER_CORE) {
+        std::cerr << "Logarithmic depth needs the core renderer, using standard depth" << std::endl;
+        depth = DEPTH_STANDARD;
+    }
+    depthMode = depth;
+    if (backend == RENDERER_CORE) {
+        return coreRenderer.init(depthMode);
+    }
+    return true;
+}
+
+void setOcclusionCulling(bool enabled) {
+    occlusionCulling = enabled;
+}
+
 void mouseButtonCallback(GLFWwindow* window, int button, int action, int mods) {
+    (void)mods;
     if (button == GLFW_MOUSE_BUTTON_LEFT) {
         if (action == GLFW_PRESS) {
             isDragging = true;
@@ -29,6 +66,7 @@ void mouseButtonCallback(GLFWwindow* window, int button, int action, int mods) {
 }
 
 void cursorPositionCallback(GLFWwindow* window, double xpos, double ypos) {
+    (void)window;
     if (isDragging) {
         double deltaX = xpos - lastMouseX;
         double deltaY = ypos - lastMouseY;
@@ -46,33 +84,109 @@ void cursorPositionCallback(GLFWwindow* window, double xpos, double ypos) {
     }
 }
 
-void display(const std::vector<Planet>& planets) {
+void remapPlanetFocus(const std::vector<int>& remap) {
+    if (planetFocus >= 0 && planetFocus < static_cast<int>(remap.size())) {
+        planetFocus = remap[planetFocus];
+    }
+}
+
+void framebufferSizeCallback(GLFWwindow* window, int width, int height) {
+    (void)window;
+    glViewport(0, 0, width, height); // En pixels : plus grand que la fenêtre sur un écran haute densité
+}
+
+// Pipeline fixe historique
+static void displayLegacy(const std::vector<Planet>& planets, const CameraState& camera) {
     glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 
+    // Rapport d'aspect du viewport : suit la fenêtre et la résolution dynamique
+    GLint viewport[4];
+    glGetIntegerv(GL_VIEWPORT, viewport);
+    double aspect = viewport[3] > 0 ? static_cast<double>(viewport[2]) / viewport[3] : 1.0;
     glMatrixMode(GL_PROJECTION);
     glLoadIdentity();
-    gluPerspective(45.0, 800.0 / 600.0, 0.00001, 100.0); // Ajuster les plans de découpe pour l'usage en AU
+    gluPerspective(camera.fovy, aspect, camera.zNear, camera.zFar); // Ajuster les plans de découpe pour l'usage en AU
 
     glMatrixMode(GL_MODELVIEW);
     glLoadIdentity();
 
-    // Calculer la position de la caméra en utilisant les angles de rotation
-    double cameraX = planets[planetFocus].x / AU + zoomFactor * cos(cameraPhi) * sin(cameraTheta);
-    double cameraY = planets[planetFocus].y / AU + zoomFactor * sin(cameraPhi);
-    double cameraZ = planets[planetFocus].z / AU + zoomFactor * cos(cameraPhi) * cos(cameraTheta);
-
-    gluLookAt(cameraX, cameraY, cameraZ,  // Position de la caméra
-              planets[planetFocus].x / AU, planets[planetFocus].y / AU, planets[planetFocus].z / AU,  // Point de référence (planète)
-              0.0, -1.0, 0.0);         // Vecteur "up"
-
+    gluLookAt(camera.eye[0], camera.eye[1], camera.eye[2],          // Position de la caméra
+              camera.target[0], camera.target[1], camera.target[2], // Point de référence (planète)
+              camera.up[0], camera.up[1], camera.up[2]);            // Vecteur "up"
+
+    RenderView view = captureRenderView(camera.eye[0], camera.eye[1], camera.eye[2]);
+    if (depthMode == DEPTH_REVERSE_Z) {
+        // Le découpage a lu la projection classique ; le GPU reçoit la projection inversée
+        double reversed[16];
+        matrixPerspectiveReversed(camera.fovy, aspect, camera.zNear, reversed);
+        glMatrixMode(GL_PROJECTION);
+        glLoadMatrixd(reversed);
+        glMatrixMode(GL_MODELVIEW);
+    }
+    OccluderSet occluders;
+    if (occlusionCulling) {
+        occluders.collect(view, planets);
+        view.occluders = &occluders;
+    }
+    renderQueue.begin(planets.size() * 3); // Trajectoire, corps ou point, anneaux
     for (const auto& planet : planets) {
-        planet.draw();
+        planet.enqueue(view, renderQueue);
     }
+    renderState.invalidate();
+    renderQueue.submit(renderState, view.frustum);
+}
 
-    glfwSwapBuffers(glfwGetCurrentContext());
+// Indice du corps focusId : l'indice connu s'il est toujours le bon, sinon une recherche (après un
+// rangement, une fusion ou une touche). Un corps absorbé cède la place à celui que remapPlanetFocus
+// a choisi, qui devient le corps focalisé.
+static void resolveFocus(const std::vector<Planet>& planets) {
+    if (planetFocus >= static_cast<int>(planets.size())) {
+        planetFocus = static_cast<int>(planets.size()) - 1;
+    }
+    if (planets[planetFocus].id == focusId) {
+        return;
+    }
+    for (size_t k = 0; k < planets.size(); ++k) {
+        if (planets[k].id == focusId) {
+            planetFocus = static_cast<int>(k);
+            return;
+        }
+    }
+    focusId = planets[planetFocus].id;
+}
+
+void display(const std::vector<Planet>& planets) {
+    resolveFocus(planets);
 
-    std::cout << "zoom: " << zoomFactor << std::endl;
-    std::cout << "radius: " << planets[1].radius / AU << std::endl;
+    // Calculer la position de la caméra en utilisant les angles de rotation
+    const Planet& focus = planets[planetFocus];
+    CameraState camera;
+    camera.target[0] = focus.x / AU;
+    camera.target[1] = focus.y / AU;
+    camera.target[2] = focus.z / AU;
+    camera.eye[0] = camera.target[0] + zoomFactor * cos(cameraPhi) * sin(cameraTheta);
+    camera.eye[1] = camera.target[1] + zoomFactor * sin(cameraPhi);
+    camera.eye[2] = camera.target[2] + zoomFactor * cos(cameraPhi) * cos(cameraTheta);
+    camera.up[0] = 0.0;
+    camera.up[1] = -1.0;
+    camera.up[2] = 0.0;
+    camera.fovy = 45.0;
+    // Avec la profondeur inversée ou logarithmique, le plan proche peut descendre à environ
+    // 1,5 km sans perdre la précision lointaine : de la surface d'une lune jusqu'à Neptune
+    camera.zNear = depthMode == DEPTH_STANDARD ? 0.00001 : 0.00000001;
+    camera.zFar = 100.0;
+
+    if (depthMode == DEPTH_REVERSE_Z) {
+        depthTarget.begin();
+    }
+    if (rendererBackend == RENDERER_CORE) {
+        coreRenderer.render(planets, camera, occlusionCulling);
+    } else {
+        displayLegacy(planets, camera);
+    }
+    if (depthMode == DEPTH_REVERSE_Z) {
+        depthTarget.end();
+    }
 }
 
 void handleInput(GLFWwindow* window) {
@@ -87,7 +201,7 @@ void handleInput(GLFWwindow* window) {
 
     for (int i = GLFW_KEY_0; i <= GLFW_KEY_9; ++i) {
         if (glfwGetKey(window, i) == GLFW_PRESS) {
-            planetFocus = i - GLFW_KEY_0;
+            focusId = i - GLFW_KEY_0; // Identifiant, pas indice : le tableau peut avoir été réordonné
         }
     }
 }
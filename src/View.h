@@ -3,13 +3,29 @@
 
 #include <vector>
 #include "Planet.h"
+#include "Options.h"
 #include <GLFW/glfw3.h>
 
+// Choisir le chemin de rendu (après glewInit) ; false si le rendu core n'a pas pu être initialisé.
+// Un mode de profondeur non disponible est remplacé par DEPTH_STANDARD, avec un avertissement.
+bool initRenderer(RendererBackend backend, DepthMode depth);
+
+// Ne pas dessiner les corps cachés derrière les grands corps proches (voir OccluderSet)
+void setOcclusionCulling(bool enabled);
+
+// Dessine une image dans le framebuffer lié ; la présentation (glfwSwapBuffers) revient à l'appelant
 void display(const std::vector<Planet>& planets);
 void handleInput(GLFWwindow* window);
 
+// Suivre la planète focalisée après une fusion ou un rangement (remap[ancien indice] = nouvel
+// indice). Le corps focalisé est retrouvé par son identifiant ; remap sert quand il a été absorbé.
+void remapPlanetFocus(const std::vector<int>& remap);
+
 // Déclarations des fonctions de rappel de la souris
 void mouseButtonCallback(GLFWwindow* window, int button, int action, int mods);
 void cursorPositionCallback(GLFWwindow* window, double xpos, double ypos);
 
+// Redimensionnement : le viewport suit le framebuffer (en pixels, pas en coordonnées d'écran)
+void framebufferSizeCallback(GLFWwindow* window, int width, int height);
+
 #endif // VIEW_H
@@ -1,12 +1,38 @@
 // main.cpp
 #include <GL/glew.h>
 #include <GLFW/glfw3.h>
+#include <atomic>
+#include <cmath>
+#include <functional>
+#include <iomanip>
 #include <iostream>
+#include <thread>
 #include "Planet.h"
 #include "View.h"
-
-const double SUN_MASS = 1.989e30; // Masse du Soleil en kg
-const double DAY = 86400; // Secondes dans une journée
+#include "Collision.h"
+#include "Physics.h"
+#include "SolarSystem.h"
+#include "Ensemble.h"
+#include "Options.h"
+#include "FrameTimer.h"
+#include "Profiler.h"
+#include "Arena.h"
+#include "FrameCapture.h"
+#include "ChebyshevEphemeris.h"
+#include "Ephemeris.h"
+#include "Playback.h"
+#include "SpatialOrder.h"
+#include "Parallel.h"
+#include "Scheduler.h"
+#include "Numa.h"
+#include "Distributed.h"
+#include "RenderSnapshot.h"
+#include "ResolutionScaler.h"
+#include "Diagnostics.h"
+#include "Timestep.h"
+#include "Ias15.h"
+#include "Hybrid.h"
+#include "Splat.h"
 
 void initLighting() {
     glEnable(GL_LIGHTING);
@@ -22,19 +48,256 @@ void initLighting() {
     glLightfv(GL_LIGHT0, GL_DIFFUSE, light_diffuse);
     glLightfv(GL_LIGHT0, GL_SPECULAR, light_specular);
 
+    glEnable(GL_NORMALIZE); // Les sphères unitaires sont mises à l'échelle : renormaliser les normales
+    glEnable(GL_POINT_SMOOTH); // Points ronds pour les corps lointains
+    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA); // Anneaux translucides
+
     glEnable(GL_COLOR_MATERIAL);
     glColorMaterial(GL_FRONT, GL_AMBIENT_AND_DIFFUSE);
     glMaterialfv(GL_FRONT, GL_SPECULAR, light_specular);
     glMateriali(GL_FRONT, GL_SHININESS, 128);
 }
 
-int main() {
+// Intégrateurs de la boucle qui fait les pas, avec leur état d'un pas à l'autre
+struct Stepper {
+    TimestepController timestep; // Euler : pas fixe ou --adaptive-dt
+    Ias15Integrator ias15;
+    HybridIntegrator hybrid;
+
+    explicit Stepper(const SimulationOptions& options)
+        : timestep(options.dt, options.adaptiveTolerance, options.dtMin, options.dtMax),
+          ias15(options.ias15Epsilon, options.dt, options.dtMin, options.dtMax),
+          hybrid(options.encounterRadius, options.ias15Epsilon, options.dtMin) {
+    }
+
+    // Corps fusionnés ou réordonnés : l'historique des intégrateurs ne leur correspond plus
+    void reset() {
+        timestep.reset();
+        ias15.reset();
+        hybrid.reset();
+    }
+};
+
+// Un pas de simulation en graphe de tâches : forces, intégration par tuiles, collisions, puis
+// empreinte et enregistrement, indépendants l'un de l'autre. Retourne true si des collisions
+// ont été traitées (remap donne alors les nouveaux indices). Les pas de diagnostic mesurent
+// l'état de départ : énergie potentielle pendant la passe de forces, le reste à côté.
+// Euler : le pas vaut timestep.step() ; s'il est adaptatif, l'estimation d'erreur s'intercale
+// entre forces et intégration et choisit le pas suivant. IAS15 et hybride : le pas (de durée choisie
+// par IAS15) précède le graphe qui ne garde que collisions, empreinte et enregistrement.
+// time avance de la durée du pas.
+static bool simulateStep(TaskGraph& graph, std::vector<Planet>& planets, const SimulationOptions& options,
+                         long long step, double& time, EphemerisWriter& recorder, ConservationMonitor& monitor,
+                         Stepper& stepper, std::vector<int>& remap) {
+    graph.clear();
+    bool diagnose = options.diagnosticsInterval > 0 && (step - 1) % options.diagnosticsInterval == 0;
+    ConservationSample sample;
+    TimestepController& timestep = stepper.timestep;
+    double dt;
+    TaskGraph::TaskId integrated;
+    if (options.integrator != INTEGRATOR_EULER) {
+        if (diagnose) {
+            measureConservation(planets, sample);
+        }
+        double* potential = diagnose ? &sample.potential : nullptr;
+        dt = options.integrator == INTEGRATOR_IAS15 ? stepIas15(stepper.ias15, planets, options, potential)
+                                                    : stepper.hybrid.step(planets, options, potential);
+        integrated = graph.add([] {});
+    } else {
+        dt = timestep.step();
+        TaskGraph::TaskId forces = addForceTasks(graph, planets, options.forceMethod, options.theta, options.threads,
+                                                 options.deterministic, diagnose ? &sample.potential : nullptr);
+        if (diagnose) {
+            TaskGraph::TaskId measured = graph.add([&planets, &sample] { measureConservation(planets, sample); });
+            TaskGraph::TaskId joined = graph.add([] {});
+            graph.precede(forces, joined);
+            graph.precede(measured, joined);
+            forces = joined; // L'intégration attend aussi la mesure
+        }
+        if (timestep.adaptive()) {
+            int threads = resolveThreadCount(options.threads);
+            TaskGraph::TaskId estimated = graph.add([&planets, &timestep, threads] { timestep.estimate(planets, threads); });
+            graph.precede(forces, estimated);
+            forces = estimated; // L'intégration remet les accélérations à zéro
+        }
+        integrated = addIntegrationTasks(graph, planets, dt, forces);
+    }
+    time += dt;
+    const double now = time;
+
+    // Détecter et traiter les collisions survenues pendant le pas
+    bool collided = false;
+    TaskGraph::TaskId collisions = graph.add([&] {
+        if (options.collisionMode != COLLISION_OFF) {
+            collided = handleCollisions(planets, dt, options.collisionMode, options.restitution, remap) > 0;
+        }
+    });
+    graph.precede(integrated, collisions);
+
+    // Empreinte de l'état pour comparer deux exécutions sans exporter les trajectoires
+    if (options.hashInterval > 0 && step % options.hashInterval == 0) {
+        TaskGraph::TaskId hash = graph.add([&planets, step] {
+            std::cout << "State hash [step " << step << "]: " << std::hex << std::setw(16) << std::setfill('0')
+                      << stateHash(planets) << std::dec << std::setfill(' ') << std::endl;
+        });
+        graph.precede(collisions, hash);
+    }
+    if (recorder.isOpen() && step % options.recordInterval == 0) {
+        TaskGraph::TaskId record = graph.add([&recorder, &planets, now] { recorder.append(now, planets); });
+        graph.precede(collisions, record);
+    }
+
+    graph.run(resolveThreadCount(options.threads));
+    if (diagnose) {
+        monitor.report(step - 1, sample, std::cout);
+        if (options.integrator == INTEGRATOR_IAS15) {
+            std::cout << "Time step [step " << step << "]: " << dt << " s, next " << stepper.ias15.step() << " s"
+                      << std::endl;
+        } else if (options.integrator == INTEGRATOR_HYBRID) {
+            std::cout << "Encounters [step " << step << "]: " << stepper.hybrid.closePairs() << " close pair(s) in "
+                      << stepper.hybrid.groups() << " group(s)" << std::endl;
+        } else if (timestep.adaptive()) {
+            std::cout << "Time step [step " << step << "]: " << dt << " s, next " << timestep.step()
+                      << " s (estimated error " << timestep.lastError() << ")" << std::endl;
+        }
+    }
+    if (collided) {
+        stepper.reset();
+    }
+    return collided;
+}
+
+// --async-physics : les pas s'enchaînent sur ce thread pendant le rendu, et chacun publie un
+// instantané que l'image suivante reprend. Au plus options.physicsStepsPerFrame pas par image :
+// le thread attend ensuite que le rendu prenne le dernier état. La caméra n'est pas touchée ici :
+// le rendu suit les changements d'indices d'après les identifiants (applySnapshot).
+static void physicsLoop(std::vector<Planet>& planets, const SimulationOptions& options, EphemerisWriter& recorder,
+                        ConservationMonitor& monitor, Stepper& stepper, SnapshotBuffer& snapshots,
+                        const std::atomic<bool>& stop) {
+    TaskGraph stepGraph;
+    std::vector<int> remap;
+    double simulationTime = 0.0;
+    long long step = 0;
+    while (!stop.load(std::memory_order_acquire)) {
+        ++step;
+        simulateStep(stepGraph, planets, options, step, simulationTime, recorder, monitor, stepper, remap);
+        if (options.reorderInterval > 0 && step % options.reorderInterval == 0) {
+            sortBodiesMorton(planets, remap);
+            stepper.reset();
+        }
+        resetStepArena();
+        captureSnapshot(planets, simulationTime, step, snapshots.writeBuffer());
+        snapshots.publish(options.physicsStepsPerFrame);
+    }
+}
+
+// Rendu d'une image : dans le FBO de capture si elle est active, puis présentation dans la fenêtre
+static void renderFrame(GLFWwindow* window, const std::vector<Planet>& planets, FrameCapture& capture,
+                        ResolutionScaler& scaler, bool headless) {
+    if (capture.active()) {
+        capture.beginFrame();
+    } else if (scaler.active()) {
+        int width, height;
+        glfwGetFramebufferSize(window, &width, &height);
+        scaler.beginFrame(width, height);
+    }
+    display(planets);
+    if (capture.active()) {
+        capture.endFrame();
+        if (!headless) {
+            int width, height;
+            glfwGetFramebufferSize(window, &width, &height);
+            capture.present(width, height);
+        }
+    } else if (scaler.active()) {
+        scaler.endFrame();
+    }
+    if (!headless) {
+        glfwSwapBuffers(window);
+    }
+}
+
+// Fenêtre à la taille demandée, ou plein écran sur le moniteur principal ; les indications de
+// contexte sont posées par l'appelant
+static GLFWwindow* openWindow(const SimulationOptions& options) {
+    glfwWindowHint(GLFW_SCALE_TO_MONITOR, GLFW_TRUE); // Windows, X11 : taille multipliée par l'échelle du moniteur
+    if (options.fullscreen) {
+        GLFWmonitor* monitor = glfwGetPrimaryMonitor();
+        const GLFWvidmode* mode = monitor ? glfwGetVideoMode(monitor) : NULL;
+        if (mode) {
+            return glfwCreateWindow(mode->width, mode->height, "OpenGL Window", monitor, NULL);
+        }
+    }
+    return glfwCreateWindow(options.windowWidth, options.windowHeight, "OpenGL Window", NULL, NULL);
+}
+
+int main(int argc, char** argv) {
+    SimulationOptions options;
+    if (!parseOptions(argc, argv, options)) {
+        return -1;
+    }
+
+    setSofteningKernel(options.softening);
+    if (options.numa && !options.benchmarkNuma) {
+        schedulerPinThreads(true); // --benchmark-numa fixe lui-même les threads après le placement naïf
+    }
+
+    // Compression d'éphémérides : aucun rendu, aucune fenêtre
+    if (options.compressOutput) {
+        return runEphemerisCompression(options);
+    }
+
+    // Mesures de la localité mémoire : aucun rendu, aucune fenêtre
+    if (options.benchmarkNuma) {
+        return runNumaBenchmark(options);
+    }
+    if (options.benchmarkOrder) {
+        return runOrderBenchmark(options);
+    }
+
+    // Simulation répartie entre processus : aucun rendu, aucune fenêtre
+    if (options.distributedRanks > 0) {
+        return runDistributed(options);
+    }
+
+    // Mode ensemble : aucun rendu, aucune fenêtre
+    if (options.ensembleMembers > 0) {
+        return runEnsemble(options);
+    }
+
+    // Aperçus rastérisés sur CPU : aucun rendu OpenGL, aucune fenêtre
+    if (options.splatTarget) {
+        return runSplat(options);
+    }
+
     if (!glfwInit()) {
         std::cerr << "Failed to initialize GLFW" << std::endl;
         return -1;
     }
 
-    GLFWwindow* window = glfwCreateWindow(800, 600, "OpenGL Window", NULL, NULL);
+    // Le rendu core exige un contexte 3.3 core (forward-compatible pour macOS)
+    GLFWwindow* window = NULL;
+    if (options.headless) {
+        glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+    }
+    if (options.renderer == RENDERER_CORE) {
+        glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
+        glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
+        glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+        glfwWindowHint(GLFW_OPENGL_FORWARD_COMPAT, GL_TRUE);
+        window = openWindow(options);
+        if (!window) {
+            std::cerr << "Failed to create an OpenGL 3.3 core context, falling back to the legacy renderer" << std::endl;
+            glfwDefaultWindowHints();
+            if (options.headless) {
+                glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+            }
+            options.renderer = RENDERER_LEGACY;
+        }
+    }
+    if (!window) {
+        window = openWindow(options);
+    }
     if (!window) {
         std::cerr << "Failed to create GLFW window" << std::endl;
         glfwTerminate();
@@ -43,109 +306,158 @@ int main() {
 
     glfwMakeContextCurrent(window);
 
+    glewExperimental = GL_TRUE; // Nécessaire pour charger les fonctions d'un contexte core
     GLenum err = glewInit();
     if (GLEW_OK != err) {
         std::cerr << "Error initializing GLEW: " << glewGetErrorString(err) << std::endl;
         return -1;
     }
+    glGetError(); // glewInit peut laisser GL_INVALID_ENUM en profil core
+
+    // Le framebuffer est en pixels : sur un écran haute densité il est plus grand que la fenêtre
+    int framebufferWidth, framebufferHeight;
+    glfwGetFramebufferSize(window, &framebufferWidth, &framebufferHeight);
+    glViewport(0, 0, framebufferWidth, framebufferHeight);
+    glfwSetFramebufferSizeCallback(window, framebufferSizeCallback);
 
     glEnable(GL_DEPTH_TEST);
 
-    initLighting(); // Initialiser l'éclairage
+    if (options.renderer == RENDERER_CORE && !initRenderer(RENDERER_CORE, options.depthMode)) {
+        std::cerr << "Failed to initialize the core renderer" << std::endl;
+        return -1;
+    }
+    if (options.renderer == RENDERER_LEGACY) {
+        initRenderer(RENDERER_LEGACY, options.depthMode);
+        initLighting(); // Initialiser l'éclairage
+    }
+    setOcclusionCulling(options.occlusionCulling);
+    FrameCapture capture;
+    if (options.captureTarget &&
+        !capture.open(options.captureTarget, options.captureWidth, options.captureHeight)) {
+        glfwTerminate();
+        return -1;
+    }
+    ResolutionScaler scaler;
+    if (options.frameBudget > 0.0 && !scaler.init(options.frameBudget, options.minResolutionScale)) {
+        glfwTerminate();
+        return -1;
+    }
+    if (options.benchmarkFrames > 0 || capture.active()) {
+        glfwSwapInterval(0); // Ne pas attendre la synchronisation verticale pendant la mesure
+    }
 
     std::vector<Planet> planets;
-    // Soleil
-    planets.emplace_back(0.0, 0.0, 0.0, 696340000.0, SUN_MASS, 1.0f, 1.0f, 0.0f, "textures/sun.jpeg", 2 * M_PI / (25 * DAY)); 
-
-    // Mercure
-    double mercuryDistance = 0.39 * AU;
-    double mercuryOrbitalSpeed = sqrt(G * SUN_MASS / mercuryDistance);
-    planets.emplace_back(mercuryDistance, 0.0, 0.0, 2439700.0, 3.3011e23, 0.5f, 0.5f, 0.5f, "textures/mercury.jpg", 2 * M_PI / (58.6 * DAY));
-    planets.back().vy = mercuryOrbitalSpeed;
-
-    // Vénus
-    double venusDistance = 0.72 * AU;
-    double venusOrbitalSpeed = sqrt(G * SUN_MASS / venusDistance);
-    planets.emplace_back(venusDistance, 0.0, 0.0, 6051800.0, 4.8675e24, 1.0f, 0.5f, 0.0f, "textures/venus.jpg", -2 * M_PI / (243 * DAY));
-    planets.back().vy = venusOrbitalSpeed;
-
-    // Terre
-    double earthDistance = AU; // Distance entre la Terre et le Soleil en mètres
-    double earthOrbitalSpeed = sqrt(G * SUN_MASS / earthDistance);
-    planets.emplace_back(earthDistance, 0.0, 0.0, 6371000.0, 5.972e24, 0.0f, 0.0f, 1.0f, "textures/earth.jpeg", 2 * M_PI / DAY);   
-    planets.back().vy = earthOrbitalSpeed;
-
-    // Lune
-    double moonDistance = 384400 * 1000; // Distance Terre-Lune en mètres
-    double moonOrbitalSpeed = sqrt(G * 5.972e24 / moonDistance);
-    planets.emplace_back(earthDistance + moonDistance, 0.0, 0.0, 1737100.0, 7.347e22, 1.0f, 1.0f, 1.0f, "textures/moon.jpeg", 2 * M_PI / (27.3 * DAY));
-    planets.back().vy = earthOrbitalSpeed + moonOrbitalSpeed;
-
-    // Mars
-    double marsDistance = 1.524 * AU; // Distance entre Mars et le Soleil en mètres
-    double marsOrbitalSpeed = sqrt(G * SUN_MASS / marsDistance);
-    planets.emplace_back(marsDistance, 0.0, 0.0, 3389500.0, 6.39e23, 1.0f, 0.0f, 0.0f, "textures/mars.jpeg", 2 * M_PI / (1.03 * DAY));   
-    planets.back().vy = marsOrbitalSpeed;
-
-    // Jupiter
-    double jupiterDistance = 5.2 * AU;
-    double jupiterOrbitalSpeed = sqrt(G * SUN_MASS / jupiterDistance);
-    planets.emplace_back(jupiterDistance, 0.0, 0.0, 69911000.0, 1.8982e27, 1.0f, 0.5f, 0.0f, "textures/jupiter.jpeg", 2 * M_PI / (0.41 * DAY));
-    planets.back().vy = jupiterOrbitalSpeed;
-
-    // Saturne
-    double saturnDistance = 9.58 * AU;
-    double saturnOrbitalSpeed = sqrt(G * SUN_MASS / saturnDistance);
-    planets.emplace_back(saturnDistance, 0.0, 0.0, 58232000.0, 5.6834e26, 1.0f, 1.0f, 0.5f, "textures/saturn.jpeg", 2 * M_PI / (0.44 * DAY), "textures/saturn_ring.png");
-    planets.back().vy = saturnOrbitalSpeed;
-
-    // Uranus
-    double uranusDistance = 19.2 * AU;
-    double uranusOrbitalSpeed = sqrt(G * SUN_MASS / uranusDistance);
-    planets.emplace_back(uranusDistance, 0.0, 0.0, 25362000.0, 8.6810e25, 0.5f, 1.0f, 1.0f, "textures/uranus.jpeg", 2 * M_PI / (0.72 * DAY));
-    planets.back().vy = uranusOrbitalSpeed;
-
-    // Neptune
-    double neptuneDistance = 30.05 * AU;
-    double neptuneOrbitalSpeed = sqrt(G * SUN_MASS / neptuneDistance);
-    planets.emplace_back(neptuneDistance, 0.0, 0.0, 24622000.0, 1.02413e26, 0.5f, 0.0f, 1.0f, "textures/neptune.jpeg", 2 * M_PI / (0.67 * DAY));
-    planets.back().vy = neptuneOrbitalSpeed;
+    Playback playback;
+    EphemerisWriter recorder;
+    if (options.playbackPath) {
+        if (!playback.open(options.playbackPath, options.playbackSpeed)) {
+            glfwTerminate();
+            return -1;
+        }
+        playback.createBodies(planets);
+    } else {
+        createSolarSystem(planets);
+        addDebrisDisk(planets, options.debrisCount, options.seed);
+        assignSoftening(planets, options.softeningLength, options.softeningRadius);
+    }
+    if (options.recordPath) {
+        if (!recorder.open(options.recordPath, planets, solarSystemDefinition().size())) {
+            glfwTerminate();
+            return -1;
+        }
+        recorder.append(0.0, planets); // État initial
+    }
 
     double simulationTime = 0.0; // Temps écoulé en secondes
+    long long step = 0;
+    std::vector<int> remap;
+    TaskGraph stepGraph;
+    FrameTimer frameTimer;
+    ConservationMonitor monitor(options.energyAlert, options.momentumAlert);
+    Stepper stepper(options);
 
     glfwSetMouseButtonCallback(window, mouseButtonCallback);
     glfwSetCursorPosCallback(window, cursorPositionCallback);
 
+    // Pas asynchrone : planets appartient au thread du pas, le rendu dessine ses propres copies
+    SnapshotBuffer snapshots;
+    std::vector<Planet> rendered;
+    std::atomic<bool> stopPhysics(false);
+    std::thread physics;
+    if (options.asyncPhysics) {
+        rendered = planets;
+        physics = std::thread(physicsLoop, std::ref(planets), std::cref(options), std::ref(recorder), std::ref(monitor),
+                              std::ref(stepper), std::ref(snapshots), std::cref(stopPhysics));
+    }
+
     while (!glfwWindowShouldClose(window)) {
         handleInput(window); // Gérer les entrées de l'utilisateur
 
-        // Calculer les forces gravitationnelles
-        for (size_t i = 0; i < planets.size(); ++i) {
-            for (size_t j = i + 1; j < planets.size(); ++j) {
-                double fx, fy, fz;
-                computeGravitationalForce(planets[i], planets[j], fx, fy, fz);
-                planets[i].applyForce(fx, fy, fz);
-                planets[j].applyForce(-fx, -fy, -fz);
+        if (options.playbackPath) {
+            // Relecture : pas de boucle de forces, l'instant affiché suit l'horloge de relecture
+            playback.handleInput(window);
+            simulationTime = playback.advance(options.dt);
+            playback.update(planets);
+        } else if (options.asyncPhysics) {
+            bool fresh;
+            const RenderSnapshot& snapshot = snapshots.acquire(fresh);
+            applySnapshot(snapshot, fresh, rendered);
+            if (!snapshot.bodies.empty()) {
+                simulationTime = snapshot.simulationTime;
+            }
+        } else {
+            // Exécuter le graphe du pas, qui avance aussi le temps de simulation
+            ++step;
+            if (simulateStep(stepGraph, planets, options, step, simulationTime, recorder, monitor, stepper, remap)) {
+                remapPlanetFocus(remap);
             }
-        }
 
-        // Mettre à jour les positions des planètes
-        double dt = 60 * 60 * 24 / 365; // Intervalle de temps en secondes (1 jour)
-        for (auto& planet : planets) {
-            planet.update(dt);
+            // Ranger les corps voisins côte à côte en mémoire ; la caméra suit son corps
+            if (options.reorderInterval > 0 && step % options.reorderInterval == 0) {
+                sortBodiesMorton(planets, remap);
+                remapPlanetFocus(remap);
+                stepper.reset();
+            }
+            resetStepArena();
         }
-
-        // Mettre à jour le temps de simulation
-        simulationTime += dt;
+        const std::vector<Planet>& drawn = options.asyncPhysics ? rendered : planets;
 
         // Afficher les planètes
-        display(planets);
+        if (options.benchmarkFrames > 0) {
+            frameTimer.start();
+            renderFrame(window, drawn, capture, scaler, options.headless);
+            glFinish(); // Inclure le travail du GPU dans la mesure
+            frameTimer.stop();
+            if (frameTimer.count() >= static_cast<size_t>(options.benchmarkFrames)) {
+                frameTimer.report(options.renderer == RENDERER_CORE ? "Frame time (core)" : "Frame time (legacy)");
+                glfwSetWindowShouldClose(window, GL_TRUE);
+            }
+        } else {
+            renderFrame(window, drawn, capture, scaler, options.headless);
+        }
+        if (options.captureFrames > 0 && capture.frames() >= options.captureFrames) {
+            glfwSetWindowShouldClose(window, GL_TRUE); // Les images encore dans l'anneau sont écrites à la fermeture
+        }
+        resetFrameArena(); // Les données transitoires de l'image ne survivent pas au-delà
+        profilerEndFrame();
         glfwPollEvents();
 
         // Afficher le temps de simulation en jours
         std::cout << "Simulation Time: " << simulationTime / DAY << " days" << std::endl;
     }
 
+    if (physics.joinable()) {
+        stopPhysics.store(true, std::memory_order_release);
+        snapshots.close();
+        physics.join();
+    }
+    recorder.close();
+    playback.close();
+    capture.close();
+    scaler.destroy();
+    if (options.profile) {
+        profilerReport(std::cout);
+    }
     glfwDestroyWindow(window);
     glfwTerminate();
     return 0;